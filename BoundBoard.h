@@ -0,0 +1,119 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#ifndef BoundBoard_h
+#define BoundBoard_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+using NSPACE::vec;
+using NSPACE::lbool;
+
+namespace openwbo {
+
+/** Bounds shared by MaxSAT solvers running concurrently on the same formula.
+ *
+ *  Upper bounds are published together with their model and lower bounds
+ *  as plain values. All operations are lock-free: the bounds are atomics
+ *  that only move towards each other and the best model is an immutable
+ *  object swapped in with a compare-and-swap.
+ */
+class BoundBoard {
+
+public:
+  BoundBoard() : ub(UINT64_MAX), lb(0) {}
+
+  // Publishes a model of cost 'cost'. Returns true if it improves the best
+  // upper bound.
+  bool publishUB(uint64_t cost, vec<lbool> &model) {
+    if (cost >= ub.load())
+      return false;
+
+    std::shared_ptr<const Entry> entry(new Entry(cost, model));
+    std::shared_ptr<const Entry> current = std::atomic_load(&best);
+    do {
+      if (current != nullptr && current->cost <= cost)
+        return false;
+    } while (!std::atomic_compare_exchange_weak(&best, &current, entry));
+
+    lowerTo(ub, cost);
+    return true;
+  }
+
+  // Publishes a lower bound.
+  void publishLB(uint64_t cost) {
+    uint64_t current = lb.load();
+    while (cost > current && !lb.compare_exchange_weak(current, cost))
+      ;
+  }
+
+  uint64_t getUB() { return ub.load(); }
+  uint64_t getLB() { return lb.load(); }
+
+  // True if the best model has been proven optimal.
+  bool isClosed() { return lb.load() >= ub.load(); }
+
+  // Copies the best model into 'model' and returns its cost (UINT64_MAX if
+  // no model was published).
+  uint64_t getModel(vec<lbool> &model) {
+    std::shared_ptr<const Entry> current = std::atomic_load(&best);
+    if (current == nullptr)
+      return UINT64_MAX;
+    current->model.copyTo(model);
+    return current->cost;
+  }
+
+protected:
+  struct Entry {
+    Entry(uint64_t c, vec<lbool> &m) : cost(c) { m.copyTo(model); }
+    uint64_t cost;
+    vec<lbool> model;
+  };
+
+  static void lowerTo(std::atomic<uint64_t> &bound, uint64_t value) {
+    uint64_t current = bound.load();
+    while (value < current && !bound.compare_exchange_weak(current, value))
+      ;
+  }
+
+  std::atomic<uint64_t> ub;           // Best upper bound.
+  std::atomic<uint64_t> lb;           // Best lower bound.
+  std::shared_ptr<const Entry> best;  // Model of cost 'ub'.
+};
+
+} // namespace openwbo
+
+#endif
@@ -63,6 +63,9 @@ void Encoder::encodeCardinality(Solver *S, vec<Lit> &lits, int64_t rhs) {
   vec<Lit> lits_copy;
   lits.copyTo(lits_copy);
 
+  if (auto_cardinality)
+    cardinality_encoding = selectCardinality(lits.size(), rhs);
+
   switch (cardinality_encoding) {
   case _CARD_TOTALIZER_:
     totalizer.build(S, lits_copy, rhs);
@@ -78,6 +81,13 @@ void Encoder::encodeCardinality(Solver *S, vec<Lit> &lits, int64_t rhs) {
     cnetworks.encode(S, lits_copy, rhs);
     break;
 
+  case _CARD_ADDER_: {
+    vec<uint64_t> coeffs;
+    coeffs.growTo(lits.size(), 1);
+    adder.encode(S, lits_copy, coeffs, rhs);
+    break;
+  }
+
   default:
     printf("c Error: Invalid cardinality encoding.\n");
     printf("s UNKNOWN\n");
@@ -86,6 +96,8 @@ void Encoder::encodeCardinality(Solver *S, vec<Lit> &lits, int64_t rhs) {
 }
 
 void Encoder::addCardinality(Solver *S, Encoder &enc, int64_t rhs) {
+  selectIncrementalCardinality();
+  enc.selectIncrementalCardinality();
   if (cardinality_encoding == _CARD_TOTALIZER_ &&
       enc.cardinality_encoding == _CARD_TOTALIZER_) {
     totalizer.add(S, enc.totalizer, rhs);
@@ -112,6 +124,10 @@ void Encoder::updateCardinality(Solver *S, int64_t rhs) {
     cnetworks.update(S, rhs);
     break;
 
+  case _CARD_ADDER_:
+    adder.update(S, rhs);
+    break;
+
   default:
     printf("c Error: Invalid cardinality encoding.\n");
     printf("s UNKNOWN\n");
@@ -129,6 +145,7 @@ void Encoder::buildCardinality(Solver *S, vec<Lit> &lits, int64_t rhs) {
   vec<Lit> lits_copy;
   lits.copyTo(lits_copy);
 
+  selectIncrementalCardinality();
   switch (cardinality_encoding) {
   case _CARD_TOTALIZER_:
     totalizer.build(S, lits_copy, rhs);
@@ -153,6 +170,7 @@ void Encoder::incUpdateCardinality(Solver *S, vec<Lit> &join, vec<Lit> &lits,
   lits.copyTo(lits_copy);
   // Note: the assumption vector will be updated in this procedure
 
+  selectIncrementalCardinality();
   switch (cardinality_encoding) {
   case _CARD_TOTALIZER_:
     if (join.size() > 0)
@@ -171,6 +189,7 @@ void Encoder::incUpdateCardinality(Solver *S, vec<Lit> &join, vec<Lit> &lits,
 
 void Encoder::joinEncoding(Solver *S, vec<Lit> &lits, int64_t rhs) {
 
+  selectIncrementalCardinality();
   switch (cardinality_encoding) {
   case _CARD_TOTALIZER_:
     totalizer.join(S, lits, rhs);
@@ -198,6 +217,11 @@ void Encoder::encodePB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
   vec<uint64_t> coeffs_copy;
   coeffs.copyTo(coeffs_copy);
 
+  if (auto_pb) {
+    uint64_t clauses;
+    pb_encoding = selectPB(S, lits, coeffs, rhs, clauses);
+  }
+
   switch (pb_encoding) {
   case _PB_SWC_:
     swc.encode(S, lits_copy, coeffs_copy, rhs);
@@ -226,17 +250,23 @@ int Encoder::predictPB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
   vec<uint64_t> coeffs_copy;
   coeffs.copyTo(coeffs_copy);
 
+  uint64_t clauses = 0;
+  uint64_t vars = 0;
   switch (pb_encoding) {
   case _PB_SWC_:
-    return -1;
+    clauses = swc.predict(coeffs_copy, rhs, vars);
     break;
 
   case _PB_GTE_:
-    return gte.predict(S, lits_copy, coeffs_copy, rhs);
+    clauses = gte.predict(S, lits_copy, coeffs_copy, rhs);
     break;
 
   case _PB_ADDER_:
-    return -1;
+    clauses = adder.predict(coeffs_copy, rhs, vars);
+    break;
+
+  case _PB_AUTO_:
+    selectPB(S, lits_copy, coeffs_copy, rhs, clauses);
     break;
 
   default:
@@ -244,8 +274,9 @@ int Encoder::predictPB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
     printf("s UNKNOWN\n");
     exit(_ERROR_);
   }
-}
 
+  return clauses >= _MAX_CLAUSES_ ? _MAX_CLAUSES_ : (int)clauses;
+}
 
 // Manages the update of PB encodings.
 void Encoder::updatePB(Solver *S, uint64_t rhs) {
@@ -283,11 +314,19 @@ void Encoder::incEncodePB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
   coeffs.copyTo(coeffs_copy);
   // Note: the assumption vector will be updated in this procedure
 
+  // Adder cannot be updated incrementally: the automatic encoding uses GTE.
+  if (auto_pb)
+    pb_encoding = _PB_GTE_;
+
   switch (pb_encoding) {
   case _PB_SWC_:
     swc.encode(S, lits_copy, coeffs_copy, rhs, assumptions, size);
     break;
 
+  case _PB_GTE_:
+    gte.encode(S, lits_copy, coeffs_copy, rhs, assumptions);
+    break;
+
   default:
     printf("Error: PB encoding does not support incrementality.\n");
     printf("s UNKNOWN\n");
@@ -312,6 +351,11 @@ void Encoder::incUpdatePB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
     swc.join(S, lits_copy, coeffs_copy, assumptions);
     break;
 
+  case _PB_GTE_:
+    gte.update(S, rhs, assumptions);
+    gte.join(S, lits_copy, coeffs_copy, assumptions);
+    break;
+
   default:
     printf("Error: PB encoding does not support incrementality.\n");
     printf("s UNKNOWN\n");
@@ -320,7 +364,7 @@ void Encoder::incUpdatePB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
 }
 
 // Manages the incremental update of assumptions.
-// Currently only used for the iterative encoding with SWC.
+// Used for the iterative encodings with SWC and GTE.
 void Encoder::incUpdatePBAssumptions(Solver *S, vec<Lit> &assumptions) {
   assert(incremental_strategy == _INCREMENTAL_ITERATIVE_);
 
@@ -329,6 +373,10 @@ void Encoder::incUpdatePBAssumptions(Solver *S, vec<Lit> &assumptions) {
     swc.updateAssumptions(S, assumptions);
     break;
 
+  case _PB_GTE_:
+    gte.updateAssumptions(assumptions);
+    break;
+
   default:
     printf("Error: PB encoding does not support incrementality.\n");
     printf("s UNKNOWN\n");
@@ -364,6 +412,8 @@ bool Encoder::hasCardEncoding() {
     return mtotalizer.hasCreatedEncoding();
   else if (cardinality_encoding == _CARD_CNETWORKS_)
     return cnetworks.hasCreatedEncoding();
+  else if (cardinality_encoding == _CARD_ADDER_)
+    return adder.hasCreatedEncoding();
 
   return false;
 }
@@ -374,6 +424,102 @@ bool Encoder::hasPBEncoding() {
     return swc.hasCreatedEncoding();
   else if (pb_encoding == _PB_GTE_)
     return gte.hasCreatedEncoding();
+  else if (pb_encoding == _PB_ADDER_)
+    return adder.hasCreatedEncoding();
 
   return false;
 }
+
+// Size of an encoding when comparing encodings: an auxiliary variable counts
+// as several clauses since it also enlarges the search space of the solver.
+static uint64_t encodingCost(uint64_t clauses, uint64_t vars) {
+  return clauses + 4 * vars;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  selectCardinality : (nb_lits : int) (rhs : int64_t) ->  [int]
+  |
+  |  Description:
+  |
+  |     Returns the cardinality encoding of smallest predicted size (see
+  |     'encodingCost') for a constraint over 'nb_lits' literals. If all of
+  |     them exceed a size of _MAX_CLAUSES_, the Adder encoding is returned.
+  |
+  |________________________________________________________________________________________________@*/
+int Encoder::selectCardinality(int nb_lits, int64_t rhs) {
+  if (rhs == 0 || rhs >= nb_lits)
+    return _CARD_TOTALIZER_;
+
+  int encodings[] = {_CARD_TOTALIZER_, _CARD_MTOTALIZER_, _CARD_CNETWORKS_};
+  int best = _CARD_ADDER_;
+  uint64_t best_cost = UINT64_MAX;
+
+  for (int i = 0; i < 3; i++) {
+    uint64_t clauses = 0;
+    uint64_t vars = 0;
+    if (encodings[i] == _CARD_TOTALIZER_)
+      clauses = totalizer.predict(nb_lits, rhs, vars);
+    else if (encodings[i] == _CARD_MTOTALIZER_)
+      clauses = mtotalizer.predict(nb_lits, rhs, vars);
+    else
+      clauses = cnetworks.predict(nb_lits, rhs, vars);
+
+    uint64_t cost = encodingCost(clauses, vars);
+    if (cost < _MAX_CLAUSES_ && cost < best_cost) {
+      best = encodings[i];
+      best_cost = cost;
+    }
+  }
+
+  return best;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  selectPB : (S : Solver *) (lits : vec<Lit>&) (coeffs : vec<uint64_t>&)
+  |             (rhs : uint64_t) (clauses : uint64_t&) ->  [int]
+  |
+  |  Description:
+  |
+  |     Returns the PB encoding of smallest predicted size (see
+  |     'encodingCost') among SWC and GTE. If both exceed a size of
+  |     _MAX_CLAUSES_, the Adder encoding is returned.
+  |
+  |  Post-conditions:
+  |    * 'clauses' is the predicted number of clauses of the returned
+  |      encoding.
+  |
+  |________________________________________________________________________________________________@*/
+int Encoder::selectPB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
+                      uint64_t rhs, uint64_t &clauses) {
+  uint64_t swc_vars = 0;
+  uint64_t swc_clauses = swc.predict(coeffs, rhs, swc_vars);
+
+  vec<Lit> lits_copy;
+  lits.copyTo(lits_copy);
+  vec<uint64_t> coeffs_copy;
+  coeffs.copyTo(coeffs_copy);
+  uint64_t gte_vars = 0;
+  uint64_t gte_clauses = gte.predict(S, lits_copy, coeffs_copy, rhs, gte_vars);
+
+  // The predicted clauses of SWC may overflow the cost.
+  uint64_t swc_cost = swc_clauses >= _MAX_CLAUSES_
+                          ? UINT64_MAX
+                          : encodingCost(swc_clauses, swc_vars);
+  uint64_t gte_cost = encodingCost(gte_clauses, gte_vars);
+
+  if (swc_cost >= _MAX_CLAUSES_ && gte_cost >= _MAX_CLAUSES_) {
+    uint64_t vars;
+    clauses = adder.predict(coeffs, rhs, vars);
+    return _PB_ADDER_;
+  }
+
+  if (swc_cost < gte_cost) {
+    clauses = swc_clauses;
+    return _PB_SWC_;
+  }
+
+  clauses = gte_clauses;
+  return _PB_GTE_;
+}
@@ -64,6 +64,8 @@ public:
     amo_encoding = amo;
     incremental_strategy = incremental;
     cardinality_encoding = cardinality;
+    auto_cardinality = (cardinality == _CARD_AUTO_);
+    auto_pb = (pb == _PB_AUTO_);
     totalizer.setIncremental(incremental);
   }
 
@@ -113,7 +115,8 @@ public:
   void encodePB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs);
   // Update the rhs of an already existent pseudo-Boolean constraint.
   void updatePB(Solver *S, uint64_t rhs);
-  // Predicts the number of clauses needed for the encoding
+  // Predicts the number of clauses needed for the encoding (at most
+  // _MAX_CLAUSES_).
   int predictPB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs);
 
   // Incremental PB encodings:
@@ -122,7 +125,8 @@ public:
   void incEncodePB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
                    int64_t rhs, vec<Lit> &assumptions, int size);
 
-  // Incremental update of PB encodings.
+  // Incremental update of PB encodings: changes the rhs to 'rhs' and joins
+  // the literals 'lits' to the constraint (SWC and GTE).
   void incUpdatePB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
                    int64_t rhs, vec<Lit> &assumptions);
 
@@ -143,10 +147,21 @@ public:
 
   // Controls the type of encoding to be used:
   //
-  void setCardEncoding(int enc) { cardinality_encoding = enc; }
+  // With _CARD_AUTO_ and _PB_AUTO_ the encoding of each constraint is the one
+  // with the fewest predicted clauses (see 'selectCardinality' and
+  // 'selectPB'). 'getCardEncoding' and 'getPBEncoding' then return the
+  // encoding of the last constraint, or the automatic mode if no constraint
+  // was encoded yet.
+  void setCardEncoding(int enc) {
+    cardinality_encoding = enc;
+    auto_cardinality = (enc == _CARD_AUTO_);
+  }
   int getCardEncoding() { return cardinality_encoding; }
 
-  void setPBEncoding(int enc) { pb_encoding = enc; }
+  void setPBEncoding(int enc) {
+    pb_encoding = enc;
+    auto_pb = (enc == _PB_AUTO_);
+  }
   int getPBEncoding() { return pb_encoding; }
 
   void setAMOEncoding(int enc) { amo_encoding = enc; }
@@ -164,11 +179,41 @@ public:
     totalizer.setIncremental(incremental);
   }
 
+  // Creates the outputs of the iterative totalizer encoding on demand, when
+  // the bound is increased (see 'Totalizer::setLazy').
+  //
+  void setLazy(bool lazy) { totalizer.setLazy(lazy); }
+
+  // Records the clauses of the encodings (see 'Encodings::setRecord').
+  //
+  void setRecord(vec<Lit> *lits, vec<int> *sizes) {
+    ladder.setRecord(lits, sizes);
+    cnetworks.setRecord(lits, sizes);
+    mtotalizer.setRecord(lits, sizes);
+    totalizer.setRecord(lits, sizes);
+    adder.setRecord(lits, sizes);
+    swc.setRecord(lits, sizes);
+    gte.setRecord(lits, sizes);
+  }
+
 protected:
+  // Encodings with the fewest predicted clauses for a constraint. Adder is
+  // used if all the other encodings exceed _MAX_CLAUSES_.
+  int selectCardinality(int nb_lits, int64_t rhs);
+  int selectPB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs,
+               uint64_t &clauses);
+  // Only the totalizer encoding supports incrementality.
+  void selectIncrementalCardinality() {
+    if (auto_cardinality)
+      cardinality_encoding = _CARD_TOTALIZER_;
+  }
+
   int incremental_strategy;
   int cardinality_encoding;
   int pb_encoding;
   int amo_encoding;
+  bool auto_cardinality;
+  bool auto_pb;
 
   // At-most-one encodings
   Ladder ladder;
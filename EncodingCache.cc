@@ -0,0 +1,170 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "EncodingCache.h"
+
+using namespace openwbo;
+
+EncodingCache::~EncodingCache() {
+  for (int i = 0; i < entries.size(); i++)
+    delete entries[i];
+}
+
+void EncodingCache::encodeAMO(Solver *S, vec<Lit> &lits) {
+  vec<uint64_t> coeffs;
+  encode(S, _CACHE_AMO_, lits, coeffs, 1);
+}
+
+void EncodingCache::encodeCardinality(Solver *S, vec<Lit> &lits,
+                                      int64_t rhs) {
+  vec<uint64_t> coeffs;
+  encode(S, _CACHE_CARD_, lits, coeffs, rhs);
+}
+
+void EncodingCache::encodePB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
+                             uint64_t rhs) {
+  encode(S, _CACHE_PB_, lits, coeffs, rhs);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  encode : (S : Solver *) (type : int) (lits : vec<Lit>&)
+  |           (coeffs : vec<uint64_t>&) (rhs : uint64_t)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Adds the encoding of a constraint to 'S'. If the constraint is in the
+  |    cache its clauses are replayed, otherwise it is encoded by an 'Encoder'
+  |    whose clauses are recorded in a new entry.
+  |
+  |  Pre-conditions:
+  |    * The variables of 'lits' are created before the encoding, so that
+  |      they are smaller than its auxiliary variables.
+  |
+  |________________________________________________________________________________________________@*/
+void EncodingCache::encode(Solver *S, int type, vec<Lit> &lits,
+                           vec<uint64_t> &coeffs, uint64_t rhs) {
+  uint64_t key = hash(type, lits, coeffs, rhs);
+  Entry *e = find(key, type, lits, coeffs, rhs);
+  if (e != NULL) {
+    replay(S, e);
+    return;
+  }
+
+  Encoder enc(_INCREMENTAL_NONE_, _CARD_AUTO_, _AMO_LADDER_, _PB_AUTO_);
+  bool keep = nbLits < _MAX_CACHED_LITS_;
+  if (keep) {
+    e = new Entry();
+    e->type = type;
+    lits.copyTo(e->lits);
+    coeffs.copyTo(e->coeffs);
+    e->rhs = rhs;
+    e->first_aux = S->nVars();
+    enc.setRecord(&e->clause_lits, &e->clause_sizes);
+  }
+
+  if (type == _CACHE_AMO_)
+    enc.encodeAMO(S, lits);
+  else if (type == _CACHE_CARD_)
+    enc.encodeCardinality(S, lits, rhs);
+  else
+    enc.encodePB(S, lits, coeffs, rhs);
+
+  if (keep) {
+    e->nb_aux = S->nVars() - e->first_aux;
+    nbLits += e->clause_lits.size();
+    index.insert(std::make_pair(key, entries.size()));
+    entries.push(e);
+  }
+}
+
+// Returns the entry of a constraint, or NULL if it is not in the cache.
+EncodingCache::Entry *EncodingCache::find(uint64_t key, int type,
+                                          vec<Lit> &lits,
+                                          vec<uint64_t> &coeffs,
+                                          uint64_t rhs) {
+  std::pair<std::multimap<uint64_t, int>::iterator,
+            std::multimap<uint64_t, int>::iterator>
+      range = index.equal_range(key);
+
+  for (std::multimap<uint64_t, int>::iterator it = range.first;
+       it != range.second; ++it) {
+    Entry *e = entries[it->second];
+    if (e->type != type || e->rhs != rhs || e->lits.size() != lits.size() ||
+        e->coeffs.size() != coeffs.size())
+      continue;
+
+    bool equal = true;
+    for (int i = 0; i < lits.size() && equal; i++)
+      equal = (e->lits[i] == lits[i]);
+    for (int i = 0; i < coeffs.size() && equal; i++)
+      equal = (e->coeffs[i] == coeffs[i]);
+    if (equal)
+      return e;
+  }
+
+  return NULL;
+}
+
+// Adds the clauses of 'e' to 'S' with new auxiliary variables.
+void EncodingCache::replay(Solver *S, Entry *e) {
+  Var first = S->nVars();
+  for (int i = 0; i < e->nb_aux; i++) {
+#ifdef SIMP
+    ((NSPACE::SimpSolver *)S)->newVar();
+#else
+    S->newVar();
+#endif
+  }
+
+  int pos = 0;
+  for (int i = 0; i < e->clause_sizes.size(); i++) {
+    replay_tmp.clear();
+    for (int j = 0; j < e->clause_sizes[i]; j++) {
+      Lit l = e->clause_lits[pos++];
+      if (var(l) >= e->first_aux) {
+        assert(var(l) < e->first_aux + e->nb_aux);
+        l = mkLit(var(l) - e->first_aux + first, sign(l));
+      }
+      replay_tmp.push(l);
+    }
+    S->addClause_(replay_tmp);
+  }
+}
+
+uint64_t EncodingCache::hash(int type, vec<Lit> &lits, vec<uint64_t> &coeffs,
+                             uint64_t rhs) {
+  // FNV-1a over the words of the key.
+  uint64_t h = 14695981039346656037ULL;
+  h = (h ^ (uint64_t)type) * 1099511628211ULL;
+  h = (h ^ rhs) * 1099511628211ULL;
+  for (int i = 0; i < lits.size(); i++)
+    h = (h ^ (uint64_t)toInt(lits[i])) * 1099511628211ULL;
+  for (int i = 0; i < coeffs.size(); i++)
+    h = (h ^ coeffs[i]) * 1099511628211ULL;
+  return h;
+}
@@ -0,0 +1,109 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef EncodingCache_h
+#define EncodingCache_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include "Encoder.h"
+#include "MaxTypes.h"
+#include "core/SolverTypes.h"
+#include <map>
+#include <stdint.h>
+
+using NSPACE::vec;
+using NSPACE::Lit;
+using NSPACE::Var;
+using NSPACE::Solver;
+
+namespace openwbo {
+
+/** Cache of the encodings of the cardinality and PB constraints of a formula.
+ *
+ *  Rebuilding a SAT solver encodes the same constraints again. The cache
+ *  keeps the clauses of each encoding, keyed by the type of the constraint,
+ *  its literals, coefficients and right-hand side. An encoding that is
+ *  requested again is replayed into the new SAT solver: its auxiliary
+ *  variables are created anew and the literals of the recorded clauses are
+ *  shifted to them.
+ *
+ *  All constraints are encoded with the automatic encodings (_CARD_AUTO_ and
+ *  _PB_AUTO_) and the ladder encoding for at-most-one constraints. Once the
+ *  cache holds _MAX_CACHED_LITS_ literals, new encodings are no longer kept.
+ */
+class EncodingCache {
+
+public:
+  EncodingCache() { nbLits = 0; }
+  ~EncodingCache();
+
+  // Encode 'lits' <= 1, 'lits' <= 'rhs' and 'coeffs' * 'lits' <= 'rhs'.
+  void encodeAMO(Solver *S, vec<Lit> &lits);
+  void encodeCardinality(Solver *S, vec<Lit> &lits, int64_t rhs);
+  void encodePB(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
+                uint64_t rhs);
+
+protected:
+  enum { _CACHE_AMO_ = 0, _CACHE_CARD_, _CACHE_PB_ };
+
+  struct Entry {
+    int type;
+    vec<Lit> lits;
+    vec<uint64_t> coeffs;
+    uint64_t rhs;
+
+    // Clauses of the encoding (literals and size of each clause). The
+    // auxiliary variables are 'first_aux' to 'first_aux' + 'nb_aux' - 1.
+    vec<Lit> clause_lits;
+    vec<int> clause_sizes;
+    Var first_aux;
+    int nb_aux;
+  };
+
+  void encode(Solver *S, int type, vec<Lit> &lits, vec<uint64_t> &coeffs,
+              uint64_t rhs);
+  Entry *find(uint64_t key, int type, vec<Lit> &lits, vec<uint64_t> &coeffs,
+              uint64_t rhs);
+  void replay(Solver *S, Entry *e);
+
+  static uint64_t hash(int type, vec<Lit> &lits, vec<uint64_t> &coeffs,
+                       uint64_t rhs);
+
+  vec<Entry *> entries;
+  std::multimap<uint64_t, int> index; // Entries by the hash of their key.
+  uint64_t nbLits;                    // Literals of the cached clauses.
+  vec<Lit> replay_tmp;
+};
+
+} // namespace openwbo
+
+#endif
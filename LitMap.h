@@ -0,0 +1,89 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#ifndef LitMap_h
+#define LitMap_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+using NSPACE::vec;
+using NSPACE::Lit;
+using NSPACE::toInt;
+
+namespace openwbo {
+
+/** Map from literals to values stored in a table indexed by 'toInt(lit)'.
+ *
+ *  Used by the core-guided algorithms to map assumption literals to soft
+ *  clauses and cardinality outputs. Lookups are constant time, which matters
+ *  since they are done for every literal of every core. The table grows on
+ *  demand, so 'T' must be safe to move with 'realloc' (as any 'vec' element).
+ */
+template <class T> class LitMap {
+
+public:
+  // Returns true if 'p' is mapped to a value.
+  bool has(Lit p) const {
+    return toInt(p) < present.size() && present[toInt(p)];
+  }
+
+  // Returns the value of 'p'. As for 'std::map', 'p' is mapped to a default
+  // value if it was not mapped before.
+  T &operator[](Lit p) {
+    int i = toInt(p);
+    if (i >= present.size()) {
+      present.growTo(i + 1, false);
+      values.growTo(i + 1);
+    }
+    present[i] = true;
+    return values[i];
+  }
+
+  // Removes the value of 'p'.
+  void erase(Lit p) {
+    if (has(p))
+      present[toInt(p)] = false;
+  }
+
+  void clear() {
+    present.clear();
+    values.clear();
+  }
+
+protected:
+  vec<bool> present; // True if the literal is mapped.
+  vec<T> values;     // Value of each literal.
+};
+
+} // namespace openwbo
+
+#endif
@@ -0,0 +1,336 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "LocalSearch.h"
+
+#include "mtl/Sort.h"
+#include <algorithm>
+
+using namespace openwbo;
+
+// Increment of the weight of unsatisfied hard clauses in a local optimum.
+#define HARD_WEIGHT_INC 3
+// Maximum dynamic weight of the soft clauses with the largest weight.
+#define SOFT_WEIGHT_LIMIT 500
+// Number of candidates sampled when picking an improving variable.
+#define BMS_SAMPLES 15
+
+LocalSearch::LocalSearch(MaxSATFormula *mx)
+    : supported(true), nbVars(mx->nVars()), emptyCost(0), nbHardUnsat(0),
+      softCost(0), step(0), seed(0x9E3779B97F4A7C15ULL), nbFlips(0),
+      nbImproved(0) {
+
+  if (mx->nCard() > 0 || mx->nPB() > 0) {
+    supported = false;
+    return;
+  }
+
+  occurs.growTo(2 * nbVars);
+  clauseStart.push(0);
+
+  for (int i = 0; i < mx->nHard(); i++)
+    addClause(mx->getHardClause(i).clause, 0);
+
+  uint64_t maxWeight = 1;
+  for (int i = 0; i < mx->nSoft(); i++)
+    maxWeight = std::max(maxWeight, mx->getSoftClause(i).weight);
+  for (int i = 0; i < mx->nSoft(); i++)
+    addClause(mx->getSoftClause(i).clause, mx->getSoftClause(i).weight);
+
+  int nbClauses = weight.size();
+  limit.growTo(nbClauses, 0);
+  clauseWeight.growTo(nbClauses, 1);
+  for (int c = 0; c < nbClauses; c++) {
+    if (weight[c] == 0)
+      continue;
+    // Heavier soft clauses may get larger dynamic weights.
+    limit[c] = (int64_t)((double)weight[c] / maxWeight * SOFT_WEIGHT_LIMIT);
+    if (limit[c] < 1)
+      limit[c] = 1;
+  }
+
+  satCount.growTo(nbClauses, 0);
+  satVar.growTo(nbClauses, -1);
+  unsatPos.growTo(nbClauses, -1);
+  value.growTo(nbVars, false);
+  score.growTo(nbVars, 0);
+  lastFlip.growTo(nbVars, 0);
+  goodPos.growTo(nbVars, -1);
+}
+
+// Copies a clause without duplicate literals. Tautologies are dropped and
+// empty soft clauses only contribute to 'emptyCost'.
+void LocalSearch::addClause(const ClauseLits &lits, uint64_t w) {
+  vec<Lit> clause;
+  lits.copyTo(clause);
+  sort(clause);
+
+  int j = 0;
+  for (int i = 0; i < clause.size(); i++) {
+    if (j > 0 && clause[i] == clause[j - 1])
+      continue;
+    if (j > 0 && clause[i] == ~clause[j - 1])
+      return;
+    clause[j++] = clause[i];
+  }
+  clause.shrink(clause.size() - j);
+
+  if (clause.size() == 0) {
+    if (w == 0)
+      supported = false;
+    emptyCost += w;
+    return;
+  }
+
+  int c = weight.size();
+  for (int i = 0; i < clause.size(); i++) {
+    assert(var(clause[i]) < nbVars);
+    clauseLits.push(clause[i]);
+    occurs[toInt(clause[i])].push(c);
+  }
+  clauseStart.push(clauseLits.size());
+  weight.push(w);
+}
+
+void LocalSearch::addScore(int v, int64_t delta) {
+  score[v] += delta;
+  if (score[v] > 0 && goodPos[v] == -1) {
+    goodPos[v] = goodVars.size();
+    goodVars.push(v);
+  } else if (score[v] <= 0 && goodPos[v] != -1) {
+    int last = goodVars.last();
+    goodVars[goodPos[v]] = last;
+    goodPos[last] = goodPos[v];
+    goodVars.pop();
+    goodPos[v] = -1;
+  }
+}
+
+void LocalSearch::makeUnsat(int c) {
+  unsatPos[c] = unsat.size();
+  unsat.push(c);
+  if (weight[c] == 0)
+    nbHardUnsat++;
+  else
+    softCost += weight[c];
+}
+
+void LocalSearch::makeSat(int c) {
+  int last = unsat.last();
+  unsat[unsatPos[c]] = last;
+  unsatPos[last] = unsatPos[c];
+  unsat.pop();
+  unsatPos[c] = -1;
+  if (weight[c] == 0)
+    nbHardUnsat--;
+  else
+    softCost -= weight[c];
+}
+
+// Sets the assignment to 'model' and recomputes the state from scratch.
+void LocalSearch::init(vec<lbool> &model) {
+  for (int v = 0; v < nbVars; v++) {
+    value[v] = v < model.size() && model[v] == l_True;
+    score[v] = 0;
+    goodPos[v] = -1;
+  }
+  goodVars.clear();
+  unsat.clear();
+  nbHardUnsat = 0;
+  softCost = 0;
+
+  for (int c = 0; c < weight.size(); c++) {
+    satCount[c] = 0;
+    unsatPos[c] = -1;
+    for (int i = clauseStart[c]; i < clauseStart[c + 1]; i++) {
+      if (isTrue(clauseLits[i])) {
+        satCount[c]++;
+        satVar[c] = var(clauseLits[i]);
+      }
+    }
+
+    if (satCount[c] == 0) {
+      makeUnsat(c);
+      for (int i = clauseStart[c]; i < clauseStart[c + 1]; i++)
+        score[var(clauseLits[i])] += clauseWeight[c];
+    } else if (satCount[c] == 1)
+      score[satVar[c]] -= clauseWeight[c];
+  }
+
+  for (int v = 0; v < nbVars; v++)
+    addScore(v, 0);
+}
+
+void LocalSearch::flip(int v) {
+  value[v] = !value[v];
+  lastFlip[v] = ++step;
+  nbFlips++;
+
+  Lit p = value[v] ? mkLit(v) : ~mkLit(v); // Literal that became true.
+
+  vec<int> &made = occurs[toInt(p)];
+  for (int k = 0; k < made.size(); k++) {
+    int c = made[k];
+    int64_t w = clauseWeight[c];
+    if (++satCount[c] == 1) {
+      makeSat(c);
+      for (int i = clauseStart[c]; i < clauseStart[c + 1]; i++)
+        addScore(var(clauseLits[i]), -w);
+      addScore(v, -w);
+      satVar[c] = v;
+    } else if (satCount[c] == 2)
+      addScore(satVar[c], w);
+  }
+
+  vec<int> &broken = occurs[toInt(~p)];
+  for (int k = 0; k < broken.size(); k++) {
+    int c = broken[k];
+    int64_t w = clauseWeight[c];
+    if (--satCount[c] == 0) {
+      makeUnsat(c);
+      for (int i = clauseStart[c]; i < clauseStart[c + 1]; i++)
+        addScore(var(clauseLits[i]), w);
+      addScore(v, w);
+    } else if (satCount[c] == 1) {
+      for (int i = clauseStart[c]; i < clauseStart[c + 1]; i++) {
+        if (isTrue(clauseLits[i])) {
+          satVar[c] = var(clauseLits[i]);
+          addScore(satVar[c], -w);
+          break;
+        }
+      }
+    }
+  }
+}
+
+// Increases the weights of the unsatisfied clauses in a local optimum.
+void LocalSearch::updateWeights() {
+  for (int k = 0; k < unsat.size(); k++) {
+    int c = unsat[k];
+    int64_t inc = HARD_WEIGHT_INC;
+    if (weight[c] != 0) {
+      if (clauseWeight[c] >= limit[c])
+        continue;
+      inc = 1;
+    }
+    clauseWeight[c] += inc;
+    for (int i = clauseStart[c]; i < clauseStart[c + 1]; i++)
+      addScore(var(clauseLits[i]), inc);
+  }
+}
+
+int LocalSearch::pickVar() {
+  int best = -1;
+
+  if (goodVars.size() > 0) {
+    // Best of a sample of the improving variables (ties go to the oldest).
+    int samples = std::min(goodVars.size(), BMS_SAMPLES);
+    for (int i = 0; i < samples; i++) {
+      int v = goodVars.size() <= BMS_SAMPLES
+                  ? goodVars[i]
+                  : goodVars[random() % goodVars.size()];
+      if (best == -1 || score[v] > score[best] ||
+          (score[v] == score[best] && lastFlip[v] < lastFlip[best]))
+        best = v;
+    }
+    return best;
+  }
+
+  updateWeights();
+  if (goodVars.size() > 0 && random() % 2 == 0)
+    return goodVars[random() % goodVars.size()];
+
+  // Best variable of a random unsatisfied clause (hard clauses first).
+  int c = unsat[random() % unsat.size()];
+  for (int tries = 0; nbHardUnsat > 0 && weight[c] != 0 && tries < 10; tries++)
+    c = unsat[random() % unsat.size()];
+
+  for (int i = clauseStart[c]; i < clauseStart[c + 1]; i++) {
+    int v = var(clauseLits[i]);
+    if (best == -1 || score[v] > score[best] ||
+        (score[v] == score[best] && lastFlip[v] < lastFlip[best]))
+      best = v;
+  }
+  return best;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  improve : (model : vec<lbool>&) (cost : uint64_t&) (maxFlips : uint64_t)
+  |            ->  [bool]
+  |
+  |  Description:
+  |
+  |    Local search from 'model'. The best model of the hard clauses reached
+  |    within 'maxFlips' flips replaces 'model' if its cost is lower than the
+  |    cost of 'model'. The dynamic clause weights are kept from one call to
+  |    the next.
+  |
+  |  Pre-conditions:
+  |    * 'model' satisfies the hard clauses.
+  |
+  |  Post-conditions:
+  |    * 'cost' is the cost of 'model'.
+  |    * 'model' is updated if a better model was found.
+  |
+  |________________________________________________________________________________________________@*/
+bool LocalSearch::improve(vec<lbool> &model, uint64_t &cost,
+                          uint64_t maxFlips) {
+  if (!supported)
+    return false;
+
+  init(model);
+
+  uint64_t bestCost = softCost + emptyCost;
+  vec<int> trail; // Variables flipped since the best assignment.
+  bool improved = false;
+
+  for (uint64_t i = 0; i < maxFlips && softCost > 0; i++) {
+    int v = pickVar();
+    flip(v);
+    trail.push(v);
+
+    if (nbHardUnsat == 0 && softCost + emptyCost < bestCost) {
+      bestCost = softCost + emptyCost;
+      trail.clear();
+      improved = true;
+    }
+  }
+
+  cost = bestCost;
+  if (!improved)
+    return false;
+
+  // Undo the flips done after the best assignment.
+  for (int i = trail.size() - 1; i >= 0; i--)
+    value[trail[i]] = !value[trail[i]];
+  for (int v = 0; v < model.size() && v < nbVars; v++)
+    model[v] = value[v] ? l_True : l_False;
+
+  nbImproved++;
+  return true;
+}
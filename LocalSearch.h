@@ -0,0 +1,130 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LocalSearch_h
+#define LocalSearch_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include "MaxSATFormula.h"
+#include <stdint.h>
+
+using NSPACE::vec;
+using NSPACE::Lit;
+using NSPACE::lbool;
+
+namespace openwbo {
+
+/** Stochastic local search that improves models of a MaxSAT formula.
+ *
+ *  The search starts from a model of the hard clauses and flips one variable
+ *  at a time, guided by dynamic clause weights as in SATLike: every clause
+ *  has a weight that is increased while the clause stays unsatisfied in a
+ *  local optimum, so that the hard clauses dominate the soft ones without
+ *  the original weights getting in the way of the search.
+ *
+ *  The clauses are copied when the object is created, so that the search
+ *  is not affected by the changes the MaxSAT algorithms make to the formula.
+ *  Only formulas made of clauses are supported.
+ */
+class LocalSearch {
+
+public:
+  LocalSearch(MaxSATFormula *mx);
+
+  // False if the formula has cardinality or pseudo-Boolean constraints.
+  bool isSupported() { return supported; }
+
+  // Searches for at most 'maxFlips' flips from 'model', a model of the hard
+  // clauses. Returns true if a better model was found, in which case 'model'
+  // is replaced by it. 'cost' is set to the cost of the final 'model'.
+  bool improve(vec<lbool> &model, uint64_t &cost, uint64_t maxFlips);
+
+  uint64_t getNbFlips() { return nbFlips; }
+  int getNbImproved() { return nbImproved; }
+
+protected:
+  void addClause(const ClauseLits &lits, uint64_t w);
+
+  void init(vec<lbool> &model);
+  void flip(int v);
+  int pickVar();
+  void updateWeights();
+
+  // Score bookkeeping
+  void addScore(int v, int64_t delta);
+  void makeUnsat(int c);
+  void makeSat(int c);
+
+  bool isTrue(Lit p) { return value[var(p)] != sign(p); }
+
+  uint64_t random() {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+  }
+
+  bool supported;
+  int nbVars;
+  uint64_t emptyCost;       // Weight of the empty soft clauses.
+
+  // Clauses (copied from the formula)
+  vec<int> clauseStart;     // Clause 'c' is in [clauseStart[c], clauseStart[c+1]).
+  vec<Lit> clauseLits;      // Literals of all clauses.
+  vec<uint64_t> weight;     // Original weight (0 for hard clauses).
+  vec<int64_t> limit;       // Maximum dynamic weight of soft clauses.
+  vec<vec<int> > occurs;    // Clauses where each literal occurs.
+
+  // Search state
+  vec<bool> value;          // Current assignment.
+  vec<int> satCount;        // Number of true literals per clause.
+  vec<int> satVar;          // Some variable satisfying each clause.
+  vec<int64_t> clauseWeight; // Dynamic weight of each clause.
+  vec<int64_t> score;       // Weight gained by flipping each variable.
+  vec<uint64_t> lastFlip;   // Step of the last flip of each variable.
+  vec<int> unsat;           // Unsatisfied clauses.
+  vec<int> unsatPos;        // Position in 'unsat' (-1 if satisfied).
+  vec<int> goodVars;        // Variables with a positive score.
+  vec<int> goodPos;         // Position in 'goodVars' (-1 if not there).
+  int nbHardUnsat;          // Number of unsatisfied hard clauses.
+  uint64_t softCost;        // Weight of the unsatisfied soft clauses.
+  uint64_t step;            // Number of flips of the current search.
+  uint64_t seed;
+
+  // Statistics
+  uint64_t nbFlips;
+  int nbImproved;
+};
+
+} // namespace openwbo
+
+#endif
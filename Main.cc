@@ -31,14 +31,21 @@
 #include "utils/ParseUtils.h"
 #include "utils/System.h"
 #include <errno.h>
+#include <pthread.h>
 #include <signal.h>
+#include <sys/resource.h>
+#include <unistd.h>
 #include <zlib.h>
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <new>
 #include <stdlib.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifdef SIMP
@@ -51,12 +58,14 @@
 #include "MaxTypes.h"
 #include "ParserMaxSAT.h"
 #include "ParserPB.h"
+#include "Preprocessor.h"
 
 // Algorithms
 #include "algorithms/Alg_LinearSU.h"
 #include "algorithms/Alg_MSU3.h"
 #include "algorithms/Alg_OLL.h"
 #include "algorithms/Alg_PartMSU3.h"
+#include "algorithms/Alg_Portfolio.h"
 #include "algorithms/Alg_WBO.h"
 
 #define VER1_(x) #x
@@ -75,11 +84,37 @@ using namespace openwbo;
 
 //=================================================================================================
 
-static MaxSAT *mxsolver;
+static MaxSAT *mxsolver = NULL;
+static bool search_done = false;
+static std::mutex mxsolver_lock; // Protects the two fields above.
+
+// Waits for one of 'signals' and stops the search. The signals are blocked in
+// every other thread, so that they are handled here instead of in a signal
+// handler. The search then unwinds and 'main' prints the best model found.
+static void waitSignals(sigset_t signals) {
+  int signum;
+  if (sigwait(&signals, &signum) != 0)
+    return;
+
+  std::lock_guard<std::mutex> guard(mxsolver_lock);
+  if (search_done)
+    return;
+  if (mxsolver == NULL) {
+    // The formula is still being loaded.
+    printf("s UNKNOWN\n");
+    fflush(stdout);
+    _exit(_UNKNOWN_);
+  }
+  mxsolver->interrupt();
+}
 
-static void SIGINT_exit(int signum) {
-  mxsolver->printAnswer(_UNKNOWN_);
-  exit(_UNKNOWN_);
+// Raises the soft memory limit to the hard limit so that the answer can be
+// printed after running out of memory.
+static void liftMemoryLimit() {
+  rlimit rl;
+  getrlimit(RLIMIT_AS, &rl);
+  rl.rlim_cur = rl.rlim_max;
+  setrlimit(RLIMIT_AS, &rl);
 }
 
 //=================================================================================================
@@ -116,9 +151,9 @@ int main(int argc, char **argv) {
 
     IntOption algorithm("Open-WBO", "algorithm",
                         "Search algorithm "
-                        "(0=wbo,1=linear-su,2=msu3,3=part-msu3,4=oll,5=best)."
-                        "\n",
-                        5, IntRange(0, 5));
+                        "(0=wbo,1=linear-su,2=msu3,3=part-msu3,4=oll,5=best,"
+                        "6=portfolio).\n",
+                        5, IntRange(0, 6));
 
     IntOption partition_strategy("PartMSU3", "partition-strategy",
                                  "Partition strategy (0=sequential, "
@@ -133,20 +168,87 @@ int main(int argc, char **argv) {
 
     BoolOption bmo("Open-WBO", "bmo", "BMO search.\n", true);
 
+    IntOption core_trim("Open-WBO", "core-trim",
+                        "Rounds of core trimming (0=none) (only for "
+                        "unsat-based algorithms).\n",
+                        0, IntRange(0, INT32_MAX));
+
+    IntOption core_min_budget("Open-WBO", "core-min-budget",
+                              "Conflict budget of each SAT call in core "
+                              "minimization (0=none) (only for unsat-based "
+                              "algorithms).\n",
+                              0, IntRange(0, INT32_MAX));
+
+    IntOption core_exhaust("Open-WBO", "core-exhaust",
+                           "Conflict budget of each SAT call in core "
+                           "exhaustion (0=none) (only for msu3 and oll).\n",
+                           0, IntRange(0, INT32_MAX));
+
+    BoolOption disjoint_cores("Open-WBO", "disjoint-cores",
+                              "Collect disjoint cores before relaxing them "
+                              "(only for msu3 and unweighted oll).\n",
+                              false);
+
+    IntOption ls_flips("Open-WBO", "ls-flips",
+                       "Flips of local search from each new model "
+                       "(0=none).\n",
+                       0, IntRange(0, INT32_MAX));
+
+    BoolOption preprocess("Open-WBO", "preprocess",
+                          "Variable elimination on the hard clauses "
+                          "(only with the simp SAT solver).\n",
+                          false);
+
+    BoolOption simplify("Open-WBO", "simplify",
+                        "MaxSAT preprocessing of the formula before the "
+                        "search.\n",
+                        false);
+
+    IntOption anytime("LinearSU", "anytime",
+                      "Wall-clock seconds of the anytime linear search "
+                      "(0=none).\n",
+                      0, IntRange(0, INT32_MAX));
+
+    IntOption time_limit("Open-WBO", "time-limit",
+                         "Wall-clock time limit in seconds (0=none).\n", 0,
+                         IntRange(0, INT32_MAX));
+
+    IntOption mem_limit("Open-WBO", "mem-limit",
+                        "Memory limit in MB (0=none). Learnt clauses are "
+                        "removed when it gets close.\n", 0,
+                        IntRange(0, INT32_MAX));
+
     IntOption cardinality("Encodings", "cardinality",
                           "Cardinality encoding (0=cardinality networks, "
-                          "1=totalizer, 2=modulo totalizer).\n",
-                          1, IntRange(0, 2));
+                          "1=totalizer, 2=modulo totalizer, 3=adder, "
+                          "4=automatic).\n",
+                          1, IntRange(0, 4));
 
     IntOption amo("Encodings", "amo", "AMO encoding (0=Ladder).\n", 0,
                   IntRange(0, 0));
 
-    IntOption pb("Encodings", "pb", "PB encoding (0=SWC,1=GTE,2=Adder).\n", 1,
-                 IntRange(0, 2));
+    IntOption pb("Encodings", "pb",
+                 "PB encoding (0=SWC,1=GTE,2=Adder,3=automatic).\n", 1,
+                 IntRange(0, 3));
 
     IntOption formula("Open-WBO", "formula",
                       "Type of formula (0=WCNF, 1=OPB).\n", 0, IntRange(0, 1));
 
+    StringOption write_cache("Open-WBO", "write-cache",
+                             "Write the parsed formula to a binary cache "
+                             "file.\n",
+                             NULL);
+
+    StringOption load_cache("Open-WBO", "load-cache",
+                            "Load the formula from a binary cache file "
+                            "instead of parsing the input file.\n",
+                            NULL);
+
+    IntOption parse_threads("Open-WBO", "parse-threads",
+                            "Number of threads used to parse uncompressed "
+                            "WCNF files (1=sequential).\n",
+                            1, IntRange(1, 256));
+
     IntOption weight(
         "WBO", "weight-strategy",
         "Weight strategy (0=none, 1=weight-based, 2=diversity-based).\n", 2,
@@ -162,6 +264,18 @@ int main(int argc, char **argv) {
     parseOptions(argc, argv, true);
 
     double initial_time = cpuTime();
+    double deadline = time_limit > 0 ? wallClockTime() + time_limit : 0;
+
+    if (mem_limit > 0) {
+      rlimit rl;
+      getrlimit(RLIMIT_AS, &rl);
+      rlim_t limit = (rlim_t)mem_limit * 1024 * 1024;
+      if (rl.rlim_max == RLIM_INFINITY || limit < rl.rlim_max) {
+        rl.rlim_cur = limit;
+        if (setrlimit(RLIMIT_AS, &rl) == -1)
+          printf("c WARNING! Could not set resource limit: Virtual memory.\n");
+      }
+    }
     MaxSAT *S = NULL;
 
     switch ((int)algorithm) {
@@ -170,7 +284,7 @@ int main(int argc, char **argv) {
       break;
 
     case _ALGORITHM_LINEAR_SU_:
-      S = new LinearSU(verbosity, bmo, cardinality, pb);
+      S = new LinearSU(verbosity, bmo, cardinality, pb, anytime);
       break;
 
     case _ALGORITHM_PART_MSU3_:
@@ -188,38 +302,65 @@ int main(int argc, char **argv) {
     case _ALGORITHM_BEST_:
       break;
 
+    case _ALGORITHM_PORTFOLIO_:
+      S = new Portfolio(verbosity, cardinality, pb);
+      break;
+
     default:
       printf("c Error: Invalid MaxSAT algorithm.\n");
       printf("s UNKNOWN\n");
       exit(_ERROR_);
     }
 
-    signal(SIGXCPU, SIGINT_exit);
-    signal(SIGTERM, SIGINT_exit);
+    // Must be done before any other thread is created.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGXCPU);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+    std::thread(waitSignals, signals).detach();
 
-    if (argc == 1) {
+    if (argc == 1 && load_cache == NULL) {
       printf("c Error: no filename.\n");
       printf("s UNKNOWN\n");
       exit(_ERROR_);
     }
 
-    gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
-    if (in == NULL)
-      printf("c ERROR! Could not open file: %s\n",
-             argc == 1 ? "<stdin>" : argv[1]),
-          printf("s UNKNOWN\n"), exit(_ERROR_);
-
     MaxSATFormula *maxsat_formula = new MaxSATFormula();
-
-    if ((int)formula == _FORMAT_MAXSAT_) {
-      parseMaxSATFormula(in, maxsat_formula);
-      maxsat_formula->setFormat(_FORMAT_MAXSAT_);
+    std::chrono::steady_clock::time_point parse_start =
+        std::chrono::steady_clock::now();
+
+    if (load_cache != NULL) {
+      if (!maxsat_formula->loadCache(load_cache))
+        printf("c ERROR! Could not load formula cache: %s\n",
+               (const char *)load_cache),
+            printf("s UNKNOWN\n"), exit(_ERROR_);
     } else {
-      ParserPB *parser_pb = new ParserPB();
-      parser_pb->parsePBFormula(argv[1], maxsat_formula);
-      maxsat_formula->setFormat(_FORMAT_PB_);
+      gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
+      if (in == NULL)
+        printf("c ERROR! Could not open file: %s\n",
+               argc == 1 ? "<stdin>" : argv[1]),
+            printf("s UNKNOWN\n"), exit(_ERROR_);
+
+      if ((int)formula == _FORMAT_MAXSAT_) {
+        if (parse_threads == 1 ||
+            !parseMaxSATFormulaParallel(argv[1], maxsat_formula,
+                                        parse_threads))
+          parseMaxSATFormula(in, maxsat_formula);
+        maxsat_formula->setFormat(_FORMAT_MAXSAT_);
+      } else {
+        ParserPB *parser_pb = new ParserPB();
+        parser_pb->parsePBFormula(argv[1], maxsat_formula);
+        maxsat_formula->setFormat(_FORMAT_PB_);
+      }
+      gzclose(in);
     }
-    gzclose(in);
+
+    if (write_cache != NULL && !maxsat_formula->writeCache(write_cache))
+      printf("c ERROR! Could not write formula cache: %s\n",
+             (const char *)write_cache),
+          printf("s UNKNOWN\n"), exit(_ERROR_);
 
     printf("c |                                                                "
            "                                       |\n");
@@ -268,6 +409,44 @@ int main(int argc, char **argv) {
     printf("c |  Parse time:           %12.2f s                                "
            "                                 |\n",
            parsed_time - initial_time);
+    if (parse_threads > 1) {
+      double parse_wall_time =
+          std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                        parse_start)
+              .count();
+      printf("c |  Parse threads:        %12d                                    "
+             "                               |\n",
+             (int)parse_threads);
+      printf("c |  Parse wall time:      %12.2f s                                "
+             "                                 |\n",
+             parse_wall_time);
+    }
+
+    Preprocessor *preprocessor = NULL;
+    if (simplify) {
+      preprocessor = new Preprocessor(maxsat_formula);
+      MaxSATFormula *simplified = NULL;
+      if (!preprocessor->isSupported())
+        printf("c Warn: MaxSAT preprocessing only supports formulas made of "
+               "clauses.\n");
+      else
+        simplified = preprocessor->simplify();
+
+      if (simplified != NULL) {
+        preprocessor->printStats();
+        printf("c |  Simplified hard clauses:   %7d                            "
+               "                                       |\n",
+               simplified->nHard());
+        printf("c |  Simplified soft clauses:   %7d                            "
+               "                                       |\n",
+               simplified->nSoft());
+        maxsat_formula = simplified;
+      } else {
+        // Unsupported or unsatisfiable: the formula is solved as it is.
+        delete preprocessor;
+        preprocessor = NULL;
+      }
+    }
     printf("c |                                                                "
            "                                       |\n");
 
@@ -296,10 +475,43 @@ int main(int argc, char **argv) {
     S->setPrintModel(printmodel);
     S->setPrintSoft((const char *)printsoft);
     S->setInitialTime(initial_time);
-    mxsolver = S;
-    mxsolver->setPrint(true);
+    S->setCoreProcessing(core_trim, core_min_budget);
+    S->setCoreExhaustion(core_exhaust, disjoint_cores);
+    S->setLocalSearch(ls_flips);
+    S->setPreprocessing(preprocess);
+    S->setPreprocessor(preprocessor);
+    S->setResourceLimits(deadline, mem_limit);
+    S->setPrint(true);
+    {
+      std::lock_guard<std::mutex> guard(mxsolver_lock);
+      mxsolver = S;
+    }
 
-    int ret = (int)mxsolver->search();
+    int ret;
+    try {
+      ret = (int)S->search();
+    } catch (MaxSATInterrupt &) {
+      // Stopped by a signal or the time limit: report the best model found
+      // so far.
+      S->printAnswer(_UNKNOWN_);
+      ret = (int)S->getStatus();
+    } catch (OutOfMemoryException &) {
+      liftMemoryLimit();
+      printf("c Warn: out of memory.\n");
+      S->printAnswer(_UNKNOWN_);
+      ret = (int)S->getStatus();
+    } catch (std::bad_alloc &) {
+      liftMemoryLimit();
+      printf("c Warn: out of memory.\n");
+      S->printAnswer(_UNKNOWN_);
+      ret = (int)S->getStatus();
+    }
+    fflush(stdout);
+
+    {
+      std::lock_guard<std::mutex> guard(mxsolver_lock);
+      search_done = true;
+    }
     delete S;
     return ret;
   } catch (OutOfMemoryException &) {
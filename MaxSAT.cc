@@ -31,6 +31,29 @@
 
 using namespace openwbo;
 
+// Conflicts and propagations of each SAT call between two checks of the
+// resource limits.
+#define RESOURCE_CONFLICTS 10000
+#define RESOURCE_PROPAGATIONS 50000000
+// Fraction of the memory limit at which cheaper encodings are used and learnt
+// clauses are dropped.
+#define LOW_MEMORY_RATIO 0.8
+
+namespace {
+// SAT solver whose learnt clauses can be reduced between two SAT calls. Every
+// backend has 'reduceDB', but only as a protected method.
+template <class BaseSolver> class ReducibleSolver : public BaseSolver {
+public:
+  void reduceLearnts() { BaseSolver::reduceDB(); }
+};
+
+#ifdef SIMP
+typedef ReducibleSolver<NSPACE::SimpSolver> MaxSATSolver;
+#else
+typedef ReducibleSolver<Solver> MaxSATSolver;
+#endif
+} // namespace
+
 /************************************************************************************************
  //
  // Public methods
@@ -47,6 +70,15 @@ void MaxSAT::setInitialTime(double initial) {
   initialTime = initial;
 } // Sets the initial time.
 
+// Interrupts the search. The SAT solver is only touched while it is inside
+// 'searchSATSolver', i.e. while it cannot be deleted by the algorithm.
+void MaxSAT::interrupt() {
+  std::lock_guard<std::mutex> guard(interrupt_lock);
+  interrupted = true;
+  if (running_solver != NULL)
+    running_solver->interrupt();
+}
+
 /************************************************************************************************
  //
  // SAT solver interface
@@ -56,15 +88,16 @@ void MaxSAT::setInitialTime(double initial) {
 // Creates an empty SAT Solver.
 Solver *MaxSAT::newSATSolver() {
 
-#ifdef SIMP
-  NSPACE::SimpSolver *S = new NSPACE::SimpSolver();
-#else
-  Solver *S = new Solver();
-#endif
-
+  MaxSATSolver *S = new MaxSATSolver();
   return (Solver *)S;
 }
 
+// Removes part of the learnt clauses of a SAT solver created by
+// 'newSATSolver'.
+void MaxSAT::reduceLearnts(Solver *S) {
+  ((MaxSATSolver *)S)->reduceLearnts();
+}
+
 // Creates a new variable in the SAT solver.
 void MaxSAT::newSATVariable(Solver *S) {
 
@@ -87,28 +120,420 @@ void MaxSAT::reserveSATVariables(Solver *S, unsigned maxVariable) {
 #endif
 }
 
-// Solve the formula that is currently loaded in the SAT solver with a set of
-// assumptions and with the option to use preprocessing for 'simp'.
-lbool MaxSAT::searchSATSolver(Solver *S, vec<Lit> &assumptions, bool pre) {
+/************************************************************************************************
+ //
+ // Changes to a live SAT solver
+ //
+ ************************************************************************************************/
+
+// Adds the unit clause 'p' to the SAT solver. It is never retracted.
+void MaxSAT::addFact(Solver *S, Lit p) {
+  syncSATVariables(S);
+  S->addClause(p);
+}
+
+// Adds the binary clause 'p v q' to the SAT solver. It is never retracted.
+void MaxSAT::addFact(Solver *S, Lit p, Lit q) {
+  syncSATVariables(S);
+  S->addClause(p, q);
+}
+
+// Prevents (or allows again) the elimination of the variable of 'p' by the
+// preprocessor. Without preprocessing this has no effect.
+void MaxSAT::setFrozen(Solver *S, Lit p, bool frozen) {
+#ifdef SIMP
+  ((NSPACE::SimpSolver *)S)->setFrozen(var(p), frozen);
+#endif
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  syncSATVariables : (S : Solver *) ->  [void]
+  |
+  |  Description:
+  |
+  |    Makes the SAT solver and the MaxSAT formula agree on the number of
+  |    variables. Variables created by the encoders in the SAT solver are
+  |    reserved in the formula, and variables created in the formula (e.g.
+  |    relaxation variables) are created in the SAT solver.
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::syncSATVariables(Solver *S) {
+  maxsat_formula->newVar(S->nVars());
+  while (S->nVars() < maxsat_formula->nVars())
+    newSATVariable(S);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  activateSoftClause : (S : Solver *) (soft : int) ->  [void]
+  |
+  |  Description:
+  |
+  |    Adds soft clause 'soft' with its relaxation variables and its
+  |    assumption literal to the SAT solver. The clause only constrains the
+  |    search while the negation of the assumption literal is assumed. A new
+  |    assumption literal is created if the soft clause does not have one,
+  |    unless the soft clause can use its label (see 'getLabel').
+  |
+  |  Pre-conditions:
+  |    * The soft clause is not active in 'S' (see 'deactivateSoftClause').
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::activateSoftClause(Solver *S, int soft) {
+  Soft &s = maxsat_formula->getSoftClause(soft);
+  if (s.assumption_var == lit_Undef) {
+    s.assumption_var = s.relaxation_vars.size() == 0
+                           ? newRelaxationLiteral(soft)
+                           : maxsat_formula->newLiteral();
+  }
+  syncSATVariables(S);
+
+  // A label is the soft clause itself.
+  if (s.assumption_var == getLabel(soft)) {
+    setFrozen(S, s.assumption_var);
+    return;
+  }
+
+  vec<Lit> clause;
+  maxsat_formula->getSoftClause(soft).clause.copyTo(clause);
+  for (int i = 0; i < maxsat_formula->getSoftClause(soft).relaxation_vars.size();
+       i++)
+    clause.push(maxsat_formula->getSoftClause(soft).relaxation_vars[i]);
+  clause.push(maxsat_formula->getSoftClause(soft).assumption_var);
+
+  for (int i = 0; i < clause.size(); i++)
+    setFrozen(S, clause[i]);
+  S->addClause(clause);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  deactivateSoftClause : (S : Solver *) (soft : int) ->  [void]
+  |
+  |  Description:
+  |
+  |    Satisfies the copy of soft clause 'soft' in the SAT solver with a unit
+  |    clause on its assumption literal. The soft clause gets a new
+  |    assumption literal, so it can be activated again (e.g. with more
+  |    relaxation variables).
+  |
+  |  Pre-conditions:
+  |    * The soft clause is active in 'S'.
+  |
+  |  Post-conditions:
+  |    * 'assumption_var' of the soft clause is a new literal.
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::deactivateSoftClause(Solver *S, int soft) {
+  Lit l = maxsat_formula->getSoftClause(soft).assumption_var;
+  assert(l != lit_Undef);
+
+  // There is no copy to satisfy when the soft clause is its label.
+  if (l != getLabel(soft)) {
+    addFact(S, l);
+    setFrozen(S, l, false);
+  }
+  maxsat_formula->getSoftClause(soft).assumption_var =
+      maxsat_formula->newLiteral();
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  getLabel : (soft : int) ->  [Lit]
+  |
+  |  Description:
+  |
+  |    Returns the label of soft clause 'soft': the negation of the literal of
+  |    a unit soft clause. Its relaxation literal is true exactly when the
+  |    soft clause is falsified, as for a relaxation variable r with the hard
+  |    clause (l v r) and a cost on r.
+  |
+  |  Post-conditions:
+  |    * Returns lit_Undef if 'soft' is not a unit soft clause or if its
+  |      variable is already the label of another soft clause.
+  |
+  |________________________________________________________________________________________________@*/
+Lit MaxSAT::getLabel(int soft) {
+  const ClauseLits &clause = maxsat_formula->getSoftClause(soft).clause;
+  if (clause.size() != 1)
+    return lit_Undef;
+
+  int v = var(clause[0]);
+  if (v >= labelSoft.size())
+    labelSoft.growTo(v + 1, -1);
+  if (labelSoft[v] == -1)
+    labelSoft[v] = soft;
+  return labelSoft[v] == soft ? ~clause[0] : lit_Undef;
+}
+
+Lit MaxSAT::newRelaxationLiteral(int soft) {
+  Lit l = getLabel(soft);
+  return l != lit_Undef ? l : maxsat_formula->newLiteral();
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  freezeVariables : (S : Solver *) (assumptions : vec<Lit>&) ->  [void]
+  |
+  |  Description:
+  |
+  |    Freezes the variables that the algorithms may use after variable
+  |    elimination: the variables of soft clauses, the assumptions, and all
+  |    variables created after parsing (relaxation and assumption variables,
+  |    and the variables of the encodings). Only variables that occur in
+  |    hard clauses alone can be eliminated.
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::freezeVariables(Solver *S, vec<Lit> &assumptions) {
+  // Relaxation and assumption variables that are not yet in the SAT solver
+  // are created after preprocessing and are never eliminated.
+  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    Soft &soft = maxsat_formula->getSoftClause(i);
+    for (int j = 0; j < soft.clause.size(); j++)
+      setFrozen(S, soft.clause[j]);
+    for (int j = 0; j < soft.relaxation_vars.size(); j++)
+      if (var(soft.relaxation_vars[j]) < S->nVars())
+        setFrozen(S, soft.relaxation_vars[j]);
+    if (soft.assumption_var != lit_Undef &&
+        var(soft.assumption_var) < S->nVars())
+      setFrozen(S, soft.assumption_var);
+  }
+
+  for (int i = 0; i < assumptions.size(); i++)
+    setFrozen(S, assumptions[i]);
+
+  for (int v = maxsat_formula->nInitialVars(); v < S->nVars(); v++)
+    setFrozen(S, mkLit(v));
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  searchSATSolver : (S : Solver *) (assumptions : vec<Lit>&) (pre : bool)
+  |                    (conflicts : int64_t) ->  [lbool]
+  |
+  |  Description:
+  |
+  |    Solves the formula that is currently loaded in the SAT solver with a
+  |    set of assumptions and with the option to use preprocessing for
+  |    'simp'. At most 'conflicts' conflicts are used (-1 = no limit), in
+  |    which case l_Undef may be returned.
+  |
+  |    With a time or memory limit the solver runs in chunks of
+  |    'RESOURCE_CONFLICTS' conflicts and 'RESOURCE_PROPAGATIONS'
+  |    propagations. The limits are checked between chunks: the search is
+  |    stopped at the time limit. When the memory gets close to the memory
+  |    limit (see 'checkMemory'), part of the learnt clauses is removed
+  |    after every chunk.
+  |
+  |  Post-conditions:
+  |    * Throws 'MaxSATInterrupt' if the search was interrupted or the time
+  |      limit was reached.
+  |
+  |________________________________________________________________________________________________@*/
+lbool MaxSAT::searchSATSolver(Solver *S, vec<Lit> &assumptions, bool pre,
+                              int64_t conflicts) {
 
-// Currently preprocessing is disabled by default.
 // Variable elimination cannot be done on relaxation variables nor on variables
-// that belong to soft clauses. To preprocessing to be used those variables
-// should be frozen.
+// that belong to soft clauses. With 'preprocess' these variables are frozen and
+// variables are eliminated once, in the first call on each SAT solver.
+#ifdef SIMP
+  bool eliminate =
+      preprocess && ((NSPACE::SimpSolver *)S)->use_simplification;
+  if (eliminate)
+    freezeVariables(S, assumptions);
+#endif
+
+  {
+    std::lock_guard<std::mutex> guard(interrupt_lock);
+    if (interrupted)
+      throw MaxSATInterrupt();
+    running_solver = S;
+  }
 
+  checkMemory();
+  bool limited = time_limit > 0 || mem_limit > 0;
+  bool timeout = time_limit > 0 && wallClockTime() >= time_limit;
+  lbool res = l_Undef;
+  while (!timeout) {
+    int64_t budget = conflicts;
+    if (limited && (budget < 0 || budget > RESOURCE_CONFLICTS))
+      budget = RESOURCE_CONFLICTS;
+
+    S->budgetOff();
+    if (budget >= 0)
+      S->setConfBudget(budget);
+    if (limited)
+      S->setPropBudget(RESOURCE_PROPAGATIONS);
+
+    uint64_t start = S->conflicts;
 #ifdef SIMP
-  lbool res = ((NSPACE::SimpSolver *)S)->solveLimited(assumptions, pre);
+    res = ((NSPACE::SimpSolver *)S)->solveLimited(assumptions,
+                                                  pre || eliminate, eliminate);
 #else
-  lbool res = S->solveLimited(assumptions);
+    res = S->solveLimited(assumptions);
+#endif
+    if (res != l_Undef || !limited)
+      break;
+
+    if (time_limit > 0 && wallClockTime() >= time_limit) {
+      timeout = true;
+      break;
+    }
+    checkMemory();
+    if (low_memory)
+      reduceLearnts(S);
+
+    if (conflicts >= 0) {
+      conflicts -= S->conflicts - start;
+      if (conflicts <= 0)
+        break;
+    }
+
+    std::lock_guard<std::mutex> guard(interrupt_lock);
+    if (interrupted)
+      break;
+  }
+  S->budgetOff();
+#ifdef SIMP
+  if (eliminate)
+    nbEliminatedVars += ((NSPACE::SimpSolver *)S)->eliminated_vars;
 #endif
 
+  {
+    std::lock_guard<std::mutex> guard(interrupt_lock);
+    running_solver = NULL;
+    if (timeout) {
+      if (verbosity > 0 && print)
+        printf("c Time limit reached.\n");
+      interrupted = true;
+    }
+    if (interrupted)
+      throw MaxSATInterrupt();
+  }
+
   return res;
 }
 
+/*_________________________________________________________________________________________________
+  |
+  |  checkMemory : [void] ->  [void]
+  |
+  |  Description:
+  |
+  |    Sets 'low_memory' once the memory used reaches 'LOW_MEMORY_RATIO' of
+  |    the memory limit. From then on 'searchSATSolver' removes learnt
+  |    clauses between chunks of the search, and LinearSU encodes its
+  |    objective function with the Adder encoding.
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::checkMemory() {
+  if (mem_limit == 0 || low_memory)
+    return;
+
+  if (memUsed() >= LOW_MEMORY_RATIO * mem_limit) {
+    low_memory = true;
+    if (verbosity > 0 && print)
+      printf("c Warn: memory limit approaching, reducing memory usage.\n");
+  }
+}
+
 // Solve the formula without assumptions.
 lbool MaxSAT::searchSATSolver(Solver *S, bool pre) {
   vec<Lit> dummy; // Empty set of assumptions.
-  return searchSATSolver(S, dummy, pre);
+  return searchSATSolver(S, dummy, pre, -1);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  processCore : (S : Solver *) ->  [void]
+  |
+  |  Description:
+  |
+  |    Reduces the core 'S->conflict' found by the last SAT call.
+  |    First, the core is trimmed by solving again with the core as
+  |    assumptions until it stops shrinking (at most 'core_trim' rounds).
+  |    Then, destructive minimization removes one literal at a time and keeps
+  |    it out if the remaining literals are still a core. Each SAT call of the
+  |    minimization is limited to 'core_min_budget' conflicts; a literal whose
+  |    call runs out of budget is kept in the core.
+  |
+  |  Pre-conditions:
+  |    * The last call to 'S' returned l_False.
+  |
+  |  Post-conditions:
+  |    * 'S->conflict' is replaced by a subset that is still a core.
+  |    * 'coreProcessTime', 'nbCoreLitsRemoved' and 'nbReducedCores' are
+  |      updated.
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::processCore(Solver *S) {
+  if ((core_trim == 0 && core_min_budget == 0) || S->conflict.size() <= 1)
+    return;
+
+  double startTime = cpuTime();
+  int initialSize = S->conflict.size();
+
+  vec<Lit> core;
+  vec<Lit> assumps;
+  S->conflict.copyTo(core);
+
+  // Core trimming.
+  for (int round = 0; round < core_trim && core.size() > 1; round++) {
+    assumps.clear();
+    for (int i = 0; i < core.size(); i++)
+      assumps.push(~core[i]);
+
+    lbool res = searchSATSolver(S, assumps, false,
+                                core_min_budget > 0 ? core_min_budget : -1);
+
+    if (res != l_False || S->conflict.size() >= core.size())
+      break;
+    S->conflict.copyTo(core);
+  }
+
+  // Destructive core minimization.
+  if (core_min_budget > 0) {
+    vec<Lit> necessary;
+    coreMark.growTo(S->nVars(), false);
+
+    while (core.size() > 0) {
+      Lit p = core.last();
+      core.pop();
+
+      assumps.clear();
+      for (int i = 0; i < necessary.size(); i++)
+        assumps.push(~necessary[i]);
+      for (int i = 0; i < core.size(); i++)
+        assumps.push(~core[i]);
+
+      lbool res = searchSATSolver(S, assumps, false, core_min_budget);
+
+      if (res == l_False) {
+        // Only keep the candidates that are in the new core.
+        for (int i = 0; i < S->conflict.size(); i++)
+          coreMark[var(S->conflict[i])] = true;
+        int j = 0;
+        for (int i = 0; i < core.size(); i++)
+          if (coreMark[var(core[i])])
+            core[j++] = core[i];
+        core.shrink(core.size() - j);
+        for (int i = 0; i < S->conflict.size(); i++)
+          coreMark[var(S->conflict[i])] = false;
+      } else
+        necessary.push(p);
+    }
+
+    necessary.copyTo(core);
+  }
+
+  core.copyTo(S->conflict);
+
+  if (core.size() < initialSize) {
+    nbReducedCores++;
+    nbCoreLitsRemoved += initialSize - core.size();
+  }
+  coreProcessTime += cpuTime() - startTime;
 }
 
 /************************************************************************************************
@@ -142,6 +567,9 @@ void MaxSAT::saveModel(vec<lbool> &currentModel) {
   // original MaxSAT formula.
   for (int i = 0; i < maxsat_formula->nInitialVars(); i++)
     model.push(currentModel[i]);
+
+  if (preprocessor != NULL)
+    preprocessor->reconstruct(model);
 }
 
 /*_________________________________________________________________________________________________
@@ -156,6 +584,10 @@ void MaxSAT::saveModel(vec<lbool> &currentModel) {
   |    If a weight is specified, then it only considers the sum of the weights
   |    of the unsatisfied soft clauses with the specified weight.
   |
+  |    The set of unsatisfied soft clauses is maintained incrementally (see
+  |    'updateCostModel') and only the weights are read here since they may
+  |    change during the search.
+  |
   |  Pre-conditions:
   |    * Assumes that 'currentModel' is not empty.
   |
@@ -163,37 +595,117 @@ void MaxSAT::saveModel(vec<lbool> &currentModel) {
 uint64_t MaxSAT::computeCostModel(vec<lbool> &currentModel, uint64_t weight) {
 
   assert(currentModel.size() != 0);
+  updateCostModel(currentModel);
+
   uint64_t currentCost = 0;
+  for (int i = 0; i < costUnsat.size(); i++) {
+    uint64_t w = maxsat_formula->getSoftClause(costUnsat[i]).weight;
+    if (weight == UINT64_MAX || w == weight)
+      currentCost += w;
+  }
 
-  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    bool unsatisfied = true;
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
+  return currentCost;
+}
 
-      if (weight != UINT64_MAX &&
-          maxsat_formula->getSoftClause(i).weight != weight) {
-        unsatisfied = false;
-        continue;
-      }
+// Drops the state of the incremental cost evaluation.
+void MaxSAT::resetCostModel() {
+  costModel.clear();
+  costSatLits.clear();
+  for (int i = 0; i < costOccurs.size(); i++)
+    costOccurs[i].clear(true);
+  costOccurs.clear(true);
+  costUnsat.clear();
+  costUnsatPos.clear();
+  costNbSoft = 0;
+}
 
-      assert(var(maxsat_formula->getSoftClause(i).clause[j]) <
-             currentModel.size());
-      if ((sign(maxsat_formula->getSoftClause(i).clause[j]) &&
-           currentModel[var(maxsat_formula->getSoftClause(i).clause[j])] ==
-               l_False) ||
-          (!sign(maxsat_formula->getSoftClause(i).clause[j]) &&
-           currentModel[var(maxsat_formula->getSoftClause(i).clause[j])] ==
-               l_True)) {
-        unsatisfied = false;
-        break;
+// Starts tracking soft clause 'soft' with respect to 'costModel'. Variables
+// that are not yet tracked take their value from 'currentModel'.
+void MaxSAT::trackSoftClause(vec<lbool> &currentModel, int soft) {
+  const ClauseLits &clause = maxsat_formula->getSoftClause(soft).clause;
+
+  int satisfied = 0;
+  for (int j = 0; j < clause.size(); j++) {
+    Lit p = clause[j];
+    assert(var(p) < currentModel.size());
+
+    while (var(p) >= costModel.size())
+      costModel.push(currentModel[costModel.size()]);
+    if (costOccurs.size() <= toInt(p) + 1)
+      costOccurs.growTo(2 * (var(p) + 1));
+
+    costOccurs[toInt(p)].push(soft);
+    if ((sign(p) && costModel[var(p)] == l_False) ||
+        (!sign(p) && costModel[var(p)] == l_True))
+      satisfied++;
+  }
+
+  costSatLits.push(satisfied);
+  if (satisfied == 0) {
+    costUnsatPos.push(costUnsat.size());
+    costUnsat.push(soft);
+  } else
+    costUnsatPos.push(-1);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  updateCostModel : (currentModel : vec<lbool>&) ->  [void]
+  |
+  |  Description:
+  |
+  |    Moves the incremental cost evaluation from 'costModel' to
+  |    'currentModel'. Only the soft clauses that contain a variable whose
+  |    value differs between both models are visited. Soft clauses added to the
+  |    formula since the last call are tracked on the fly.
+  |
+  |  Post-conditions:
+  |    * 'costUnsat' contains the soft clauses unsatisfied by 'currentModel'.
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::updateCostModel(vec<lbool> &currentModel) {
+  if (costNbSoft > maxsat_formula->nSoft())
+    resetCostModel();
+
+  for (int v = 0; v < costModel.size(); v++) {
+    assert(v < currentModel.size());
+    if (costModel[v] == currentModel[v])
+      continue;
+
+    // Literal of 'v' that was satisfied by the previous model.
+    if (costModel[v] != l_Undef) {
+      Lit p = mkLit(v, costModel[v] == l_False);
+      vec<int> &occurs = costOccurs[toInt(p)];
+      for (int i = 0; i < occurs.size(); i++) {
+        int c = occurs[i];
+        if (--costSatLits[c] == 0) {
+          costUnsatPos[c] = costUnsat.size();
+          costUnsat.push(c);
+        }
       }
     }
 
-    if (unsatisfied) {
-      currentCost += maxsat_formula->getSoftClause(i).weight;
+    // Literal of 'v' that is satisfied by the current model.
+    if (currentModel[v] != l_Undef) {
+      Lit p = mkLit(v, currentModel[v] == l_False);
+      vec<int> &occurs = costOccurs[toInt(p)];
+      for (int i = 0; i < occurs.size(); i++) {
+        int c = occurs[i];
+        if (costSatLits[c]++ == 0) {
+          int last = costUnsat.last();
+          costUnsat[costUnsatPos[c]] = last;
+          costUnsatPos[last] = costUnsatPos[c];
+          costUnsat.pop();
+          costUnsatPos[c] = -1;
+        }
+      }
     }
+
+    costModel[v] = currentModel[v];
   }
 
-  return currentCost;
+  for (; costNbSoft < maxsat_formula->nSoft(); costNbSoft++)
+    trackSoftClause(currentModel, costNbSoft);
 }
 
 /*_________________________________________________________________________________________________
@@ -287,6 +799,18 @@ void MaxSAT::print_PB_configuration(int encoding) {
            "GTE");
     break;
 
+  case _PB_ADDER_:
+    printf("c |  PB Encoding:         %13s                        "
+           "                                           |\n",
+           "Adder");
+    break;
+
+  case _PB_AUTO_:
+    printf("c |  PB Encoding:         %13s                        "
+           "                                           |\n",
+           "Automatic");
+    break;
+
   default:
     printf("c Error: Invalid PB encoding.\n");
     printf("s UNKNOWN\n");
@@ -315,6 +839,18 @@ void MaxSAT::print_Card_configuration(int encoding) {
            "Modulo Totalizer");
     break;
 
+  case _CARD_ADDER_:
+    printf("c |  Cardinality Encoding: %12s                                "
+           "                                   |\n",
+           "Adder");
+    break;
+
+  case _CARD_AUTO_:
+    printf("c |  Cardinality Encoding: %12s                                "
+           "                                   |\n",
+           "Automatic");
+    break;
+
   default:
     printf("c Error: Invalid cardinality encoding.\n");
     printf("s UNKNOWN\n");
@@ -345,13 +881,133 @@ void MaxSAT::blockModel(Solver *solver) {
   solver->addClause(blocking);
 }
 
+/*_________________________________________________________________________________________________
+  |
+  |  exchangeBounds : [void] ->  [bool]
+  |
+  |  Description:
+  |
+  |    Replaces the current model by the best model found by local search or
+  |    published to the bound board if the latter is better, and publishes
+  |    'lbCost' to the bound board. Returns true if the (possibly imported)
+  |    model has a cost that is not larger than 'lbCost' or the best
+  |    published lower bound, i.e. if it is optimal.
+  |
+  |  Post-conditions:
+  |    * 'model' and 'ubCost' are updated if a better model is known.
+  |
+  |________________________________________________________________________________________________@*/
+bool MaxSAT::exchangeBounds() {
+  bool closed = false;
+  if (slsCost < ubCost) {
+    slsModel.copyTo(model);
+    ubCost = slsCost;
+    closed = lbCost >= ubCost;
+  }
+
+  if (board == NULL)
+    return closed;
+
+  board->publishLB(lbCost);
+  if (master != NULL)
+    master->shareLB(this, lbCost);
+
+  if (board->getUB() < ubCost || model.size() == 0) {
+    uint64_t cost = board->getModel(model);
+    if (cost != UINT64_MAX)
+      ubCost = cost;
+  }
+
+  return closed || (model.size() != 0 && board->getLB() >= ubCost);
+}
+
+// Exchanges the bounds (see 'exchangeBounds') and prints the answer if they
+// prove the current model optimal. Returns true in that case.
+bool MaxSAT::sharedOptimum() {
+  if (!exchangeBounds())
+    return false;
+
+  if (verbosity > 0)
+    printf("c LB = UB (shared bounds)\n");
+  printAnswer(_OPTIMUM_);
+  return true;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  setLocalSearch : (flips : int) ->  [void]
+  |
+  |  Description:
+  |
+  |    Enables the local search on the models found by the search. The
+  |    clauses of the formula are copied, so that the search starts from the
+  |    original formula even if the algorithm changes it.
+  |
+  |  Pre-conditions:
+  |    * Assumes that the formula has been loaded.
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::setLocalSearch(int flips) {
+  sls_flips = flips;
+  if (flips == 0 || sls != NULL)
+    return;
+
+  assert(maxsat_formula != NULL);
+  sls = new LocalSearch(maxsat_formula);
+  if (!sls->isSupported()) {
+    if (verbosity > 0)
+      printf("c Warn: local search only supports formulas made of clauses.\n");
+    delete sls;
+    sls = NULL;
+  }
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  printBound : (bound : int64_t) ->  [void]
+  |
+  |  Description:
+  |
+  |    Reports the bound of the model that was just saved. With local search,
+  |    the model is first improved and bounds that do not improve on the best
+  |    model found so far are not reported again.
+  |
+  |  Post-conditions:
+  |    * 'model', 'slsModel' and 'slsCost' are updated when local search is
+  |      used.
+  |
+  |________________________________________________________________________________________________@*/
 void MaxSAT::printBound(int64_t bound)
 {
+  if (sls != NULL) {
+    // 'bound' may be lower than the cost of the model (e.g. in BMO search),
+    // local search computes the actual cost.
+    uint64_t cost = bound - off_set;
+    if (cost >= slsCost)
+      return;
+    sls->improve(model, cost, sls_flips);
+    if (cost >= slsCost)
+      return;
+    bound = cost + off_set;
+    model.copyTo(slsModel);
+    slsCost = cost;
+  }
+
+  if (board != NULL)
+    board->publishUB(bound - off_set, model);
+  if (master != NULL)
+    master->shareModel(this, bound);
+
   if(!print) return;
 
   // print bound only, if its below the hard weight
   // FIXME: possible issue for PB instances when bound is negative; in MaxSAT bound is always positive
-  if( bound < (int64_t)maxsat_formula->getHardWeight() ) printf("o %" PRId64 "\n", bound);
+  // MaxSAT formulas without a hard weight ('h' prefixed hard clauses) have no such limit
+  if (maxsat_formula->getFormat() == _FORMAT_MAXSAT_ &&
+      maxsat_formula->getHardWeight() == UINT64_MAX)
+    printf("o %" PRId64 "\n", bound);
+  else if( bound < (int64_t)maxsat_formula->getHardWeight() ) printf("o %" PRId64 "\n", bound);
+  fflush(stdout);
 }
 
 // Prints the best satisfying model. Assumes that 'model' is not empty.
@@ -359,6 +1015,10 @@ void MaxSAT::printModel() {
 
   assert(model.size() != 0);
 
+  // Local search may have changed variables removed by the preprocessor.
+  if (preprocessor != NULL)
+    preprocessor->reconstruct(model);
+
   std::stringstream s;
   s << "v ";
 
@@ -383,17 +1043,17 @@ void MaxSAT::printModel() {
   printf("%s\n", s.str().c_str());
 }
 
-std::string MaxSAT::printSoftClause(int id){
-  assert (maxsat_formula->getFormat() == _FORMAT_MAXSAT_);
-  assert (id < maxsat_formula->nSoft());
+std::string MaxSAT::printSoftClause(MaxSATFormula *formula, int id) {
+  assert(formula->getFormat() == _FORMAT_MAXSAT_);
+  assert(id < formula->nSoft());
 
   std::stringstream ss;
-  ss << maxsat_formula->getSoftClause(id).weight << " ";
+  ss << formula->getSoftClause(id).weight << " ";
 
-  for (int j = 0; j < maxsat_formula->getSoftClause(id).clause.size(); j++){
-    if (sign(maxsat_formula->getSoftClause(id).clause[j]))
+  for (int j = 0; j < formula->getSoftClause(id).clause.size(); j++) {
+    if (sign(formula->getSoftClause(id).clause[j]))
       ss << "-";
-    ss << (var(maxsat_formula->getSoftClause(id).clause[j])+1) << " ";
+    ss << (var(formula->getSoftClause(id).clause[j]) + 1) << " ";
   }
   ss << "0\n";
   return ss.str();
@@ -402,33 +1062,34 @@ std::string MaxSAT::printSoftClause(int id){
 void MaxSAT::printUnsatisfiedSoftClauses() {
   assert (model.size() != 0);
 
+  // The soft clauses of the formula before preprocessing.
+  MaxSATFormula *formula =
+      preprocessor != NULL ? preprocessor->getFormula() : maxsat_formula;
+
   std::stringstream s;
   int soft_size = 0;
   
-  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+  for (int i = 0; i < formula->nSoft(); i++) {
     bool unsatisfied = true;
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
-
-      assert(var(maxsat_formula->getSoftClause(i).clause[j]) <
-             model.size());
-      if ((sign(maxsat_formula->getSoftClause(i).clause[j]) &&
-           model[var(maxsat_formula->getSoftClause(i).clause[j])] ==
-               l_False) ||
-          (!sign(maxsat_formula->getSoftClause(i).clause[j]) &&
-           model[var(maxsat_formula->getSoftClause(i).clause[j])] ==
-               l_True)) {
+    for (int j = 0; j < formula->getSoftClause(i).clause.size(); j++) {
+
+      assert(var(formula->getSoftClause(i).clause[j]) < model.size());
+      if ((sign(formula->getSoftClause(i).clause[j]) &&
+           model[var(formula->getSoftClause(i).clause[j])] == l_False) ||
+          (!sign(formula->getSoftClause(i).clause[j]) &&
+           model[var(formula->getSoftClause(i).clause[j])] == l_True)) {
         unsatisfied = false;
         break;
       }
     }
 
     if (unsatisfied) {
-      s << printSoftClause(i);
+      s << printSoftClause(formula, i);
       soft_size++;
     }
   }
   FILE * file = fopen (getPrintSoftFilename(),"w");
-  fprintf(file,"p cnf %d %d\n",maxsat_formula->nInitialVars(),soft_size);
+  fprintf(file,"p cnf %d %d\n",model.size(),soft_size);
   fprintf(file,"%s", s.str().c_str());
 }
 
@@ -449,11 +1110,32 @@ void MaxSAT::printStats() {
   printf("c  Nb UNSAT calls:         %12d\n", nbCores);
   printf("c  Average core size:      %12.2f\n", avgCoreSize);
   printf("c  Nb symmetry clauses:    %12d\n", nbSymmetryClauses);
+  if (core_trim > 0 || core_min_budget > 0) {
+    printf("c  Nb reduced cores:       %12d\n", nbReducedCores);
+    printf("c  Core literals removed:  %12" PRIu64 "\n", nbCoreLitsRemoved);
+    printf("c  Core processing time:   %12.2f s\n", coreProcessTime);
+  }
+  if (core_exhaust_budget > 0)
+    printf("c  Nb exhausted bounds:    %12d\n", nbExhaustedBounds);
+  if (disjoint_cores)
+    printf("c  Nb disjoint cores:      %12d\n", nbDisjointCores);
+  if (preprocess)
+    printf("c  Nb eliminated vars:     %12d\n", nbEliminatedVars);
+  if (sls != NULL) {
+    printf("c  Nb local search flips:  %12" PRIu64 "\n", sls->getNbFlips());
+    printf("c  Nb improved models:     %12d\n", sls->getNbImproved());
+  }
   printf("c\n");
 }
 
 // Prints the corresponding answer.
 void MaxSAT::printAnswer(int type) {
+  // The algorithm may not know about the best model found by local search.
+  if (slsCost < ubCost && type != _UNSATISFIABLE_) {
+    slsModel.copyTo(model);
+    ubCost = slsCost;
+  }
+
   if (verbosity > 0 && print)
     printStats();
 
@@ -503,8 +1185,11 @@ uint64_t MaxSAT::getUB() {
   for (int i = 0; i < maxsat_formula->nVars() + maxsat_formula->nSoft(); i++)
     newSATVariable(solver);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    solver->addClause(maxsat_formula->getHardClause(i).clause);
+  vec<Lit> hard_clause;
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    maxsat_formula->getHardClause(i).clause.copyTo(hard_clause);
+    solver->addClause(hard_clause);
+  }
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
@@ -521,10 +1206,9 @@ uint64_t MaxSAT::getUB() {
   }
 
   int limit = 1000;
-  solver->setConfBudget(limit);
 
   vec<Lit> dummy;
-  lbool res = searchSATSolver(solver, dummy);
+  lbool res = searchSATSolver(solver, dummy, false, limit);
   if (res == l_True) {
     uint64_t ub = computeCostModel(solver->model);
     return ub;
@@ -549,8 +1233,11 @@ std::pair<uint64_t, int> MaxSAT::getLB() {
   for (int i = 0; i < maxsat_formula->nVars() + maxsat_formula->nSoft(); i++)
     newSATVariable(solver);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    solver->addClause(maxsat_formula->getHardClause(i).clause);
+  vec<Lit> hard_clause;
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    maxsat_formula->getHardClause(i).clause.copyTo(hard_clause);
+    solver->addClause(hard_clause);
+  }
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
@@ -582,8 +1269,7 @@ std::pair<uint64_t, int> MaxSAT::getLB() {
   }
 
   while (res == l_False) {
-    solver->setConfBudget(limit);
-    res = searchSATSolver(solver, assumptions);
+    res = searchSATSolver(solver, assumptions, false, limit);
     if (res == l_False) {
 
       for (int i = 0; i < solver->conflict.size(); i++) {
@@ -36,11 +36,16 @@
 #include "core/Solver.h"
 #endif
 
+#include "BoundBoard.h"
+#include "EncodingCache.h"
+#include "LocalSearch.h"
+#include "Preprocessor.h"
 #include "MaxSATFormula.h"
 #include "MaxTypes.h"
 #include "utils/System.h"
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <set>
 #include <utility>
 #include <vector>
@@ -52,6 +57,7 @@ using NSPACE::mkLit;
 using NSPACE::lbool;
 using NSPACE::Solver;
 using NSPACE::cpuTime;
+using NSPACE::memUsed;
 
 namespace openwbo {
 
@@ -81,6 +87,36 @@ public:
     print_soft = false;
     print = false;
     unsat_soft_file = NULL;
+
+    costNbSoft = 0;
+
+    master = NULL;
+    board = NULL;
+    running_solver = NULL;
+    interrupted = false;
+
+    core_trim = 0;
+    core_min_budget = 0;
+    coreProcessTime = 0;
+    nbCoreLitsRemoved = 0;
+    nbReducedCores = 0;
+
+    core_exhaust_budget = 0;
+    disjoint_cores = false;
+    nbExhaustedBounds = 0;
+    nbDisjointCores = 0;
+
+    sls = NULL;
+    sls_flips = 0;
+    slsCost = UINT64_MAX;
+
+    time_limit = 0;
+    mem_limit = 0;
+    low_memory = false;
+
+    preprocess = false;
+    nbEliminatedVars = 0;
+    preprocessor = NULL;
   }
 
   MaxSAT() {
@@ -105,11 +141,43 @@ public:
     print_soft = false;
     print = false;
     unsat_soft_file = NULL;
+
+    costNbSoft = 0;
+
+    master = NULL;
+    board = NULL;
+    running_solver = NULL;
+    interrupted = false;
+
+    core_trim = 0;
+    core_min_budget = 0;
+    coreProcessTime = 0;
+    nbCoreLitsRemoved = 0;
+    nbReducedCores = 0;
+
+    core_exhaust_budget = 0;
+    disjoint_cores = false;
+    nbExhaustedBounds = 0;
+    nbDisjointCores = 0;
+
+    sls = NULL;
+    sls_flips = 0;
+    slsCost = UINT64_MAX;
+
+    time_limit = 0;
+    mem_limit = 0;
+    low_memory = false;
+
+    preprocess = false;
+    nbEliminatedVars = 0;
+    preprocessor = NULL;
   }
 
   virtual ~MaxSAT() {
     if (maxsat_formula != NULL)
       delete maxsat_formula;
+    if (sls != NULL)
+      delete sls;
   }
 
   void setInitialTime(double initial); // Set initial time.
@@ -142,6 +210,7 @@ public:
     }
 
     ubCost = maxsat_formula->getSumWeights();
+    resetCostModel();
   }
 
   void blockModel(Solver *solver);
@@ -169,6 +238,40 @@ public:
   void setPrint(bool doPrint) { print = doPrint; }
   bool getPrint() { return print; }
 
+  // Core processing: 'trim' rounds of core trimming and destructive core
+  // minimization with a conflict budget of 'budget' per SAT call (0=none).
+  void setCoreProcessing(int trim, int budget) {
+    core_trim = trim;
+    core_min_budget = budget;
+  }
+
+  // Core exhaustion with a conflict budget of 'budget' per SAT call (0=none)
+  // and disjoint-core phases (only for MSU3 and OLL).
+  void setCoreExhaustion(int budget, bool disjoint) {
+    core_exhaust_budget = budget;
+    disjoint_cores = disjoint;
+  }
+
+  // Stops the search at the wall-clock time 'deadline' (0=none) and uses
+  // cheaper encodings when the memory used gets close to 'mem' MB (0=none).
+  void setResourceLimits(double deadline, int mem) {
+    time_limit = deadline;
+    mem_limit = mem;
+  }
+
+  // Variable elimination on the hard clauses before the first SAT call of
+  // each SAT solver (only with the simp version of the SAT solver).
+  void setPreprocessing(bool pre) { preprocess = pre; }
+
+  // The formula was simplified by 'pre': models are reconstructed with it
+  // and the unsatisfied soft clauses of its original formula are printed.
+  void setPreprocessor(Preprocessor *pre) { preprocessor = pre; }
+
+  // Local search with 'flips' flips from every new model (0=none). The
+  // formula is copied, so this must be called after 'loadFormula' and before
+  // the search changes the formula.
+  virtual void setLocalSearch(int flips);
+
   void setPrintSoft(const char* file) { 
     if (file != NULL){
       unsat_soft_file = (char*)malloc(sizeof(char) * (sizeof(file)));
@@ -186,6 +289,38 @@ public:
    */
   StatusCode getStatus() { return searchStatus; }
 
+  /** return the best model found so far (empty if none) */
+  vec<lbool> &getModel() { return model; }
+
+  /** run as a worker of 'm'
+   *
+   *  Every new upper bound found by this solver is forwarded to the master
+   *  through 'shareModel'. Used by the portfolio.
+   */
+  void setMaster(MaxSAT *m) { master = m; }
+
+  /** receive a new upper bound 'bound' (and its model) found by 'worker' */
+  virtual void shareModel(MaxSAT *worker, int64_t bound) {}
+
+  /** receive a new lower bound 'bound' found by 'worker' */
+  virtual void shareLB(MaxSAT *worker, uint64_t bound) {}
+
+  /** exchange bounds with the solvers sharing 'b'
+   *
+   *  Models are published to 'b' when the bound is printed and lower bounds
+   *  by 'exchangeBounds'. The bounds of the other solvers are used to stop
+   *  the search early.
+   */
+  void setBoundBoard(BoundBoard *b) { board = b; }
+
+  /** stop the search
+   *
+   *  The running SAT call (if any) is interrupted and the next call to
+   *  'searchSATSolver' throws 'MaxSATInterrupt', which unwinds 'search'.
+   *  This method is thread-safe.
+   */
+  virtual void interrupt();
+
   /** return truth values for variables
    *
    *  This method returns the truth value for a variable in the internal
@@ -204,14 +339,94 @@ protected:
   // Interface with the SAT solver
   //
   Solver *newSATSolver(); // Creates a SAT solver.
+  void reduceLearnts(Solver *S); // Removes learnt clauses of a SAT solver.
   // Solves the formula that is currently loaded in the SAT solver.
-  lbool searchSATSolver(Solver *S, vec<Lit> &assumptions, bool pre = false);
+  // With 'conflicts' >= 0, returns l_Undef if the call runs out of conflicts.
+  lbool searchSATSolver(Solver *S, vec<Lit> &assumptions, bool pre = false,
+                        int64_t conflicts = -1);
   lbool searchSATSolver(Solver *S, bool pre = false);
 
   void newSATVariable(Solver *S); // Creates a new variable in the SAT solver.
 
   void reserveSATVariables(Solver *S, unsigned maxVariable); // Reserve space for multiple variables in the SAT solver.
 
+  // Changes to a live SAT solver
+  //
+  // These methods change a SAT solver in place, so that it does not have to
+  // be rebuilt when the working formula changes.
+  void addFact(Solver *S, Lit p);        // Adds the permanent clause 'p'.
+  void addFact(Solver *S, Lit p, Lit q); // Adds the permanent clause 'p v q'.
+  // Protects the variable of 'p' from elimination by the preprocessor.
+  void setFrozen(Solver *S, Lit p, bool frozen = true);
+  // Makes 'S' and the formula agree on the number of variables.
+  void syncSATVariables(Solver *S);
+  // Adds soft clause 'soft' to 'S' guarded by its assumption literal.
+  void activateSoftClause(Solver *S, int soft);
+  // Satisfies the copy of soft clause 'soft' in 'S' for good.
+  void deactivateSoftClause(Solver *S, int soft);
+
+  // Labels
+  //
+  // A unit soft clause (l) is relaxed by its label ~l: it needs neither a new
+  // relaxation variable nor the clause (l v r), since the SAT solver discards
+  // the tautology (l v ~l). A variable is the label of at most one soft
+  // clause.
+  Lit getLabel(int soft); // Label of soft clause 'soft' (or lit_Undef).
+  // Relaxation literal of soft clause 'soft': its label or a new literal.
+  Lit newRelaxationLiteral(int soft);
+  vec<int> labelSoft; // Soft clause labelled by each variable (-1 if none).
+
+  // Core processing
+  //
+  // Reduces the core 'S->conflict' before it is relaxed.
+  void processCore(Solver *S);
+
+  int core_trim;              // Number of rounds of core trimming.
+  int core_min_budget;        // Conflict budget of each minimization call.
+  double coreProcessTime;     // Time spent in core processing.
+  uint64_t nbCoreLitsRemoved; // Literals removed from cores.
+  int nbReducedCores;         // Number of cores that were reduced.
+  vec<bool> coreMark;         // Auxiliary marks indexed by variable.
+
+  int core_exhaust_budget; // Conflict budget of each core exhaustion call.
+  bool disjoint_cores;     // Collects disjoint cores before relaxing them.
+  int nbExhaustedBounds;   // Bounds increased by core exhaustion.
+  int nbDisjointCores;     // Cores whose relaxation was delayed.
+
+  // Encodings of the cardinality and PB constraints of the formula, replayed
+  // when a SAT solver is rebuilt.
+  EncodingCache encoding_cache;
+
+  // Local search
+  //
+  LocalSearch *sls;       // Improves the models found by the search (or NULL).
+  int sls_flips;          // Flips of each local search call.
+  vec<lbool> slsModel;    // Best model known (including local search ones).
+  uint64_t slsCost;       // Cost of 'slsModel' (UINT64_MAX if none).
+
+  // Preprocessing
+  //
+  bool preprocess;      // Eliminates variables before the first SAT call.
+  int nbEliminatedVars; // Variables eliminated by the preprocessor.
+  // Freezes the variables that may be used after preprocessing.
+  void freezeVariables(Solver *S, vec<Lit> &assumptions);
+  Preprocessor *preprocessor; // MaxSAT preprocessing of the formula (or NULL).
+
+  // Resource limits
+  //
+  double time_limit; // Wall-clock time at which the search stops (0=none).
+  int mem_limit;     // Memory limit in MB (0=none).
+  bool low_memory;   // Set when the memory used gets close to 'mem_limit'.
+  void checkMemory(); // Updates 'low_memory'.
+
+  // Interruption of the search
+  //
+  MaxSAT *master;          // Solver that coordinates this one (or NULL).
+  BoundBoard *board;       // Bounds shared with other solvers (or NULL).
+  Solver *running_solver;  // SAT solver inside 'searchSATSolver' (or NULL).
+  bool interrupted;        // Set once 'interrupt' has been called.
+  std::mutex interrupt_lock; // Protects the two fields above.
+
   // Properties of the MaxSAT formula
   //
   vec<lbool> model; // Stores the best satisfying model.
@@ -251,12 +466,34 @@ protected:
   uint64_t computeCostModel(vec<lbool> &currentModel,
                             uint64_t weight = UINT64_MAX);
 
+  // Incremental cost evaluation
+  //
+  // The cost of consecutive models is computed by only visiting the soft
+  // clauses that contain a variable whose value changed since the last call.
+  void resetCostModel();                        // Drops the cached state.
+  void updateCostModel(vec<lbool> &currentModel); // Moves to a new model.
+  void trackSoftClause(vec<lbool> &currentModel, int soft); // Adds a soft.
+
+  vec<lbool> costModel;      // Model used in the last cost evaluation.
+  vec<int> costSatLits;      // Number of satisfied literals per soft clause.
+  vec<vec<int> > costOccurs; // Soft clauses where each literal occurs.
+  vec<int> costUnsat;        // Soft clauses unsatisfied by 'costModel'.
+  vec<int> costUnsatPos;     // Position in 'costUnsat' (-1 if satisfied).
+  int costNbSoft;            // Number of soft clauses being tracked.
+
+  // Publishes 'lbCost' and imports a better model from the bound board.
+  // Returns true if the current model is proven optimal.
+  bool exchangeBounds();
+  // Calls 'exchangeBounds' and prints the answer if the model is optimal.
+  bool sharedOptimum();
+
   // Utils for printing
   //
   void printBound(int64_t bound); // Print the current bound.
   void printModel(); // Print the best satisfying model.
   void printStats(); // Print search statistics.
-  std::string printSoftClause(int id); // Prints a soft clause.
+  // Prints a soft clause.
+  std::string printSoftClause(MaxSATFormula *formula, int id);
   void printUnsatisfiedSoftClauses(); // Prints unsatisfied soft clauses.
 
   // Greater than comparator.
@@ -25,26 +25,58 @@
  *
  */
 
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <iostream>
 
 #include "MaxSATFormula.h"
 
 using namespace openwbo;
 
+// Copies the formula. The objective function is not copied: it is expected to
+// have been converted into soft clauses already (see 'MaxSAT::loadFormula').
 MaxSATFormula *MaxSATFormula::copyMaxSATFormula() {
-  assert(format == _FORMAT_MAXSAT_);
-
   MaxSATFormula *copymx = new MaxSATFormula();
   copymx->setInitialVars(nVars());
 
   for (int i = 0; i < nVars(); i++)
     copymx->newVar();
 
-  for (int i = 0; i < nSoft(); i++)
-    copymx->addSoftClause(getSoftClause(i).weight, getSoftClause(i).clause);
+  copymx->soft_lits.capacity(soft_lits.size());
+  copymx->hard_lits.capacity(hard_lits.size());
 
-  for (int i = 0; i < nHard(); i++)
-    copymx->addHardClause(getHardClause(i).clause);
+  vec<Lit> clause;
+  for (int i = 0; i < nSoft(); i++) {
+    getSoftClause(i).clause.copyTo(clause);
+    copymx->addSoftClause(getSoftClause(i).weight, clause);
+  }
+
+  for (int i = 0; i < nHard(); i++) {
+    getHardClause(i).clause.copyTo(clause);
+    copymx->addHardClause(clause);
+  }
+
+  for (int i = 0; i < nCard(); i++)
+    copymx->cardinality_constraints.push(
+        new Card(cardinality_constraints[i]->_lits,
+                 cardinality_constraints[i]->_rhs));
+
+  for (int i = 0; i < nPB(); i++)
+    copymx->pb_constraints.push(
+        new PB(pb_constraints[i]->_lits, pb_constraints[i]->_coeffs,
+               pb_constraints[i]->_rhs, pb_constraints[i]->_sign));
+
+  copymx->_nameToIndex = _nameToIndex;
+  copymx->_indexToName = _indexToName;
+  // The objective function is already encoded as soft clauses: the copy is
+  // solved as a MaxSAT formula. Only PB formulas without an objective function
+  // (decision problems) keep their format.
+  copymx->setFormat(getObjFunction() != NULL ? _FORMAT_MAXSAT_ : getFormat());
 
   copymx->setProblemType(getProblemType());
   copymx->updateSumWeights(getSumWeights());
@@ -54,12 +86,19 @@ MaxSATFormula *MaxSATFormula::copyMaxSATFormula() {
   return copymx;
 }
 
+// Appends 'lits' to the literal arena 'lits_arena' and returns its handle.
+static ClauseLits storeClause(vec<Lit> &lits_arena, vec<Lit> &lits) {
+  int offset = lits_arena.size();
+  for (int i = 0; i < lits.size(); i++)
+    lits_arena.push(lits[i]);
+  return ClauseLits(&lits_arena, offset, lits.size());
+}
+
 // Adds a new hard clause to the hard clause database.
 void MaxSATFormula::addHardClause(vec<Lit> &lits) {
   hard_clauses.push();
-  vec<Lit> copy_lits;
-  lits.copyTo(copy_lits);
-  new (&hard_clauses[hard_clauses.size() - 1]) Hard(copy_lits);
+  new (&hard_clauses[hard_clauses.size() - 1])
+      Hard(storeClause(hard_lits, lits));
   n_hard++;
 }
 
@@ -68,11 +107,9 @@ void MaxSATFormula::addSoftClause(uint64_t weight, vec<Lit> &lits) {
   soft_clauses.push();
   vec<Lit> vars;
   Lit assump = lit_Undef;
-  vec<Lit> copy_lits;
-  lits.copyTo(copy_lits);
 
   new (&soft_clauses[soft_clauses.size() - 1])
-      Soft(copy_lits, weight, assump, vars);
+      Soft(storeClause(soft_lits, lits), weight, assump, vars);
   n_soft++;
 }
 
@@ -82,11 +119,9 @@ void MaxSATFormula::addSoftClause(uint64_t weight, vec<Lit> &lits,
                                   vec<Lit> &vars) {
   soft_clauses.push();
   Lit assump = lit_Undef;
-  vec<Lit> copy_lits;
-  lits.copyTo(copy_lits);
 
   new (&soft_clauses[soft_clauses.size() - 1])
-      Soft(copy_lits, weight, assump, vars);
+      Soft(storeClause(soft_lits, lits), weight, assump, vars);
   n_soft++;
 }
 
@@ -222,3 +257,253 @@ void MaxSATFormula::convertPBtoMaxSAT() {
   else
     setProblemType(_WEIGHTED_);
 }
+
+/************************************************************************************************
+ //
+ // Binary formula cache
+ //
+ ************************************************************************************************/
+
+// The cache is a flat dump of the formula as it is after parsing: a header
+// with the scalar properties followed by the soft/hard literal arenas and the
+// PB database. It is written with the native endianness and is only meant to
+// be read back by the same build.
+#define _CACHE_MAGIC_ "OWBOFC01"
+
+static bool writeData(FILE *f, const void *data, size_t size) {
+  return size == 0 || fwrite(data, 1, size, f) == size;
+}
+
+static bool writeValue(FILE *f, uint64_t v) {
+  return writeData(f, &v, sizeof(v));
+}
+
+template <class T> static bool writeVec(FILE *f, const vec<T> &v) {
+  return writeValue(f, v.size()) &&
+         (v.size() == 0 || writeData(f, &v[0], sizeof(T) * v.size()));
+}
+
+bool MaxSATFormula::writeCache(const char *file) {
+  FILE *f = fopen(file, "wb");
+  if (f == NULL)
+    return false;
+
+  vec<uint64_t> soft_weights;
+  vec<int> soft_sizes, hard_sizes;
+  for (int i = 0; i < nSoft(); i++) {
+    soft_weights.push(soft_clauses[i].weight);
+    soft_sizes.push(soft_clauses[i].clause.size());
+  }
+  for (int i = 0; i < nHard(); i++)
+    hard_sizes.push(hard_clauses[i].clause.size());
+
+  bool ok = writeData(f, _CACHE_MAGIC_, 8) && writeValue(f, format) &&
+            writeValue(f, problem_type) && writeValue(f, n_vars) &&
+            writeValue(f, hard_weight) && writeValue(f, sum_soft_weight) &&
+            writeValue(f, max_soft_weight) && writeVec(f, soft_weights) &&
+            writeVec(f, soft_sizes) && writeVec(f, soft_lits) &&
+            writeVec(f, hard_sizes) && writeVec(f, hard_lits);
+
+  ok = ok && writeValue(f, nCard());
+  for (int i = 0; ok && i < nCard(); i++)
+    ok = writeValue(f, cardinality_constraints[i]->_rhs) &&
+         writeVec(f, cardinality_constraints[i]->_lits);
+
+  ok = ok && writeValue(f, nPB());
+  for (int i = 0; ok && i < nPB(); i++)
+    ok = writeValue(f, pb_constraints[i]->_rhs) &&
+         writeValue(f, pb_constraints[i]->_sign) &&
+         writeVec(f, pb_constraints[i]->_lits) &&
+         writeVec(f, pb_constraints[i]->_coeffs);
+
+  ok = ok && writeValue(f, objective_function != NULL);
+  if (ok && objective_function != NULL)
+    ok = writeValue(f, objective_function->_const) &&
+         writeVec(f, objective_function->_lits) &&
+         writeVec(f, objective_function->_coeffs);
+
+  ok = ok && writeValue(f, _indexToName.size());
+  for (indexMap::const_iterator it = _indexToName.begin();
+       ok && it != _indexToName.end(); ++it)
+    ok = writeValue(f, it->first) && writeValue(f, it->second.size()) &&
+         writeData(f, it->second.c_str(), it->second.size());
+
+  return fclose(f) == 0 && ok;
+}
+
+// Sequential reader over the memory-mapped cache.
+class CacheReader {
+public:
+  CacheReader(const char *data, size_t size)
+      : pos(data), end(data + size), ok(true) {}
+
+  bool read(void *data, size_t size) {
+    if (!ok || (size_t)(end - pos) < size)
+      return ok = false;
+    memcpy(data, pos, size);
+    pos += size;
+    return true;
+  }
+
+  uint64_t value() {
+    uint64_t v = 0;
+    read(&v, sizeof(v));
+    return v;
+  }
+
+  template <class T> void readVec(vec<T> &v) {
+    uint64_t size = value();
+    if (!ok || size > (uint64_t)(end - pos) / sizeof(T)) {
+      ok = false;
+      return;
+    }
+    v.clear();
+    v.growTo(size);
+    if (size > 0)
+      read(&v[0], sizeof(T) * size);
+  }
+
+  bool readString(std::string &s) {
+    uint64_t size = value();
+    if (!ok || size > (uint64_t)(end - pos))
+      return ok = false;
+    s.assign(pos, size);
+    pos += size;
+    return true;
+  }
+
+  const char *pos;
+  const char *end;
+  bool ok;
+};
+
+// Checks that the literals loaded from the cache are over 'n_vars' variables.
+static bool validLits(const vec<Lit> &lits, int n_vars) {
+  for (int i = 0; i < lits.size(); i++)
+    if (var(lits[i]) < 0 || var(lits[i]) >= n_vars)
+      return false;
+  return true;
+}
+
+bool MaxSATFormula::loadCache(const char *file) {
+  assert(nSoft() == 0 && nHard() == 0);
+
+  int fd = open(file, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return false;
+  }
+
+  size_t length = st.st_size;
+  void *data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+
+  CacheReader in((const char *)data, length);
+  char magic[8];
+  if (!in.read(magic, 8) || memcmp(magic, _CACHE_MAGIC_, 8) != 0) {
+    munmap(data, length);
+    return false;
+  }
+
+  format = in.value();
+  problem_type = in.value();
+  n_vars = in.value();
+  hard_weight = in.value();
+  sum_soft_weight = in.value();
+  max_soft_weight = in.value();
+
+  vec<uint64_t> soft_weights;
+  vec<int> soft_sizes, hard_sizes;
+  in.readVec(soft_weights);
+  in.readVec(soft_sizes);
+  in.readVec(soft_lits);
+  in.readVec(hard_sizes);
+  in.readVec(hard_lits);
+
+  uint64_t n = in.value();
+  for (uint64_t i = 0; in.ok && i < n; i++) {
+    Card *c = new Card();
+    c->_rhs = in.value();
+    in.readVec(c->_lits);
+    cardinality_constraints.push(c);
+  }
+
+  n = in.value();
+  for (uint64_t i = 0; in.ok && i < n; i++) {
+    PB *p = new PB();
+    p->_rhs = in.value();
+    p->_sign = in.value();
+    in.readVec(p->_lits);
+    in.readVec(p->_coeffs);
+    pb_constraints.push(p);
+  }
+
+  if (in.value()) {
+    objective_function = new PBObjFunction();
+    objective_function->_const = in.value();
+    in.readVec(objective_function->_lits);
+    in.readVec(objective_function->_coeffs);
+  }
+
+  n = in.value();
+  for (uint64_t i = 0; in.ok && i < n; i++) {
+    int id = in.value();
+    std::string name;
+    if (in.readString(name)) {
+      _nameToIndex.insert(std::pair<std::string, int>(name, id));
+      _indexToName.insert(std::pair<int, std::string>(id, name));
+    }
+  }
+
+  munmap(data, length);
+
+  if (!in.ok || soft_weights.size() != soft_sizes.size() ||
+      !validLits(soft_lits, n_vars) || !validLits(hard_lits, n_vars))
+    return false;
+  for (int i = 0; i < nCard(); i++)
+    if (!validLits(cardinality_constraints[i]->_lits, n_vars))
+      return false;
+  for (int i = 0; i < nPB(); i++)
+    if (!validLits(pb_constraints[i]->_lits, n_vars) ||
+        pb_constraints[i]->_coeffs.size() != pb_constraints[i]->_lits.size())
+      return false;
+  if (objective_function != NULL &&
+      (!validLits(objective_function->_lits, n_vars) ||
+       objective_function->_coeffs.size() !=
+           objective_function->_lits.size()))
+    return false;
+
+  // Rebuild the clause handles over the loaded arenas.
+  int offset = 0;
+  soft_clauses.capacity(soft_sizes.size());
+  for (int i = 0; i < soft_sizes.size(); i++) {
+    if (soft_sizes[i] < 0 || offset + soft_sizes[i] > soft_lits.size())
+      return false;
+    soft_clauses.push();
+    new (&soft_clauses[i])
+        Soft(ClauseLits(&soft_lits, offset, soft_sizes[i]), soft_weights[i],
+             lit_Undef, vec<Lit>());
+    offset += soft_sizes[i];
+  }
+  n_soft = soft_clauses.size();
+
+  offset = 0;
+  hard_clauses.capacity(hard_sizes.size());
+  for (int i = 0; i < hard_sizes.size(); i++) {
+    if (hard_sizes[i] < 0 || offset + hard_sizes[i] > hard_lits.size())
+      return false;
+    hard_clauses.push();
+    new (&hard_clauses[i])
+        Hard(ClauseLits(&hard_lits, offset, hard_sizes[i]));
+    offset += hard_sizes[i];
+  }
+  n_hard = hard_clauses.size();
+
+  return true;
+}
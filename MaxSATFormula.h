@@ -50,25 +50,49 @@ namespace openwbo {
 typedef std::map<std::string, int> nameMap;
 typedef std::map<int, std::string> indexMap;
 
+class ClauseLits {
+  /*! The ClauseLits class is a view over the literals of a clause that are
+   * stored contiguously in a literal arena of a MaxSAT formula. */
+public:
+  ClauseLits() : arena(NULL), offset(0), sz(0) {}
+  ClauseLits(const vec<Lit> *lits, int start, int n)
+      : arena(lits), offset(start), sz(n) {}
+
+  int size() const { return sz; }
+  const Lit &operator[](int i) const {
+    assert(i < sz);
+    return (*arena)[offset + i];
+  }
+
+  void copyTo(vec<Lit> &copy) const {
+    copy.clear();
+    copy.growTo(sz);
+    for (int i = 0; i < sz; i++)
+      copy[i] = (*arena)[offset + i];
+  }
+
+protected:
+  const vec<Lit> *arena; //!< Arena where the literals are stored
+  int offset;            //!< Position of the first literal in the arena
+  int sz;                //!< Number of literals
+};
+
 class Soft {
 
 public:
   /*! The soft class is used to model the soft clauses in a MaxSAT formula. */
-  Soft(const vec<Lit> &soft, uint64_t soft_weight, Lit assump_var,
+  Soft(const ClauseLits &soft, uint64_t soft_weight, Lit assump_var,
        const vec<Lit> &relax) {
-    soft.copyTo(clause);
+    clause = soft;
     weight = soft_weight;
     assumption_var = assump_var;
     relax.copyTo(relaxation_vars);
   }
 
   Soft() {}
-  ~Soft() {
-    clause.clear();
-    relaxation_vars.clear();
-  }
+  ~Soft() { relaxation_vars.clear(); }
 
-  vec<Lit> clause;    //!< Soft clause
+  ClauseLits clause;  //!< Soft clause
   uint64_t weight;    //!< Weight of the soft clause
   Lit assumption_var; //!< Assumption variable used for retrieving the core
   vec<Lit> relaxation_vars; //!< Relaxation variables that will be added to the
@@ -78,12 +102,12 @@ public:
 class Hard {
   /*! The hard class is used to model the hard clauses in a MaxSAT formula. */
 public:
-  Hard(const vec<Lit> &hard) { hard.copyTo(clause); }
+  Hard(const ClauseLits &hard) { clause = hard; }
 
   Hard() {}
-  ~Hard() { clause.clear(); }
+  ~Hard() {}
 
-  vec<Lit> clause; //!< Hard clause
+  ClauseLits clause; //!< Hard clause
 };
 
 class MaxSATFormula {
@@ -99,15 +123,13 @@ public:
   }
 
   ~MaxSATFormula() {
-    for (int i = 0; i < nSoft(); i++) {
-      soft_clauses[i].clause.clear();
+    for (int i = 0; i < nSoft(); i++)
       soft_clauses[i].relaxation_vars.clear();
-    }
     soft_clauses.clear();
+    soft_lits.clear(true);
 
-    for (int i = 0; i < nHard(); i++)
-      hard_clauses[i].clause.clear();
     hard_clauses.clear();
+    hard_lits.clear(true);
   }
 
   MaxSATFormula *copyMaxSATFormula();
@@ -187,11 +209,19 @@ public:
 
   indexMap &getIndexToName() { return _indexToName; }
 
+  /*! Write the formula to a binary cache file. */
+  bool writeCache(const char *file);
+
+  /*! Load the formula from a binary cache file written by 'writeCache'. */
+  bool loadCache(const char *file);
+
 protected:
   // MaxSAT database
   //
   vec<Soft> soft_clauses; //<! Stores the soft clauses of the MaxSAT formula.
   vec<Hard> hard_clauses; //<! Stores the hard clauses of the MaxSAT formula.
+  vec<Lit> soft_lits;     //<! Literal arena of the soft clauses.
+  vec<Lit> hard_lits;     //<! Literal arena of the hard clauses.
 
   // PB database
   //
@@ -67,8 +67,11 @@ void MaxSAT_Partition::init() {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(_solver);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    _solver->addClause(maxsat_formula->getHardClause(i).clause);
+  vec<Lit> hard_clause;
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    maxsat_formula->getHardClause(i).clause.copyTo(hard_clause);
+    _solver->addClause(hard_clause);
+  }
 
   _graphMappingVar.clear();
   _graphMappingHard.clear();
@@ -129,7 +132,7 @@ void MaxSAT_Partition::splitRandom() {
   }
 }
 
-int MaxSAT_Partition::unassignedLiterals(vec<Lit> &sc) {
+int MaxSAT_Partition::unassignedLiterals(const ClauseLits &sc) {
   int u = 0;
   for (int i = 0; i < sc.size(); i++)
     if (_solver->value(sc[i]) == l_True)
@@ -236,7 +239,7 @@ void MaxSAT_Partition::buildVIGPartitions() {
 
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
     // Compute which partition the hard clause belongs to...
-    vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+    const ClauseLits &c = maxsat_formula->getHardClause(ci).clause;
     if (unassignedLiterals(c) == 0)
       continue;
 
@@ -358,7 +361,7 @@ Graph *MaxSAT_Partition::buildVIGGraph(bool weighted) {
 
   int nEdges = 0;
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
-    vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+    const ClauseLits &c = maxsat_formula->getHardClause(ci).clause;
     int ul = unassignedLiterals(c); // returns 0 if c is satisfied
     if (ul == 0)
       continue;
@@ -475,7 +478,7 @@ Graph *MaxSAT_Partition::buildCVIGGraph(bool weighted) {
 
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
     if (_graphMappingHard[ci] != -1) { // -1 if it is not unresolved
-      vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+      const ClauseLits &c = maxsat_formula->getHardClause(ci).clause;
       int ul = unassignedLiterals(c);
 
       // printf("c Clause %d is unresolved\n", ci);
@@ -537,8 +540,8 @@ Graph *MaxSAT_Partition::buildCVIGGraph(bool weighted) {
   return g;
 }
 
-int MaxSAT_Partition::markUnassignedLiterals(vec<Lit> &c, int *markedLits,
-                                             bool v) {
+int MaxSAT_Partition::markUnassignedLiterals(const ClauseLits &c,
+                                             int *markedLits, bool v) {
   int u = 0;
   for (int i = 0; i < c.size(); i++) {
     if (_solver->value(c[i]) != l_Undef)
@@ -594,7 +597,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
 
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
     if (_graphMappingHard[ci] != -1) { // -1 if it is not unresolved
-      vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+      const ClauseLits &c = maxsat_formula->getHardClause(ci).clause;
 
       for (int i = 0; i < c.size(); i++) {
         if (_solver->value(c[i]) != l_Undef)
@@ -606,7 +609,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
 
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
     if (_graphMappingHard[ci] != -1) { // -1 if it is not unresolved
-      vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+      const ClauseLits &c = maxsat_formula->getHardClause(ci).clause;
 
       // Mark clause literals - returns number of unassigned literals
       int mrk = markUnassignedLiterals(c, markedLits, true);
@@ -621,7 +624,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
           if (ri <= ci)
             continue; // avoid duplication checks
 
-          vec<Lit> &rc = maxsat_formula->getHardClause(ri).clause;
+          const ClauseLits &rc = maxsat_formula->getHardClause(ri).clause;
           int rl = 0, ul = mrk - 1;
 
           for (int j = 0; j < rc.size(); j++) {
@@ -669,7 +672,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
   // Connect soft clauses with hard clauses!!!
   for (int ci = 0; ci < maxsat_formula->nSoft(); ci++) {
     if (_graphMappingSoft[ci] != -1) { // -1 if it is not unresolved
-      vec<Lit> &c = maxsat_formula->getSoftClause(ci).clause;
+      const ClauseLits &c = maxsat_formula->getSoftClause(ci).clause;
 
       // Mark clause literals
       int mrk = markUnassignedLiterals(c, markedLits, true);
@@ -683,7 +686,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
           int ri = litClauses[li][iter];
           // if (ri <= ci) continue; //avoid duplication checks
 
-          vec<Lit> &rc = maxsat_formula->getHardClause(ri).clause;
+          const ClauseLits &rc = maxsat_formula->getHardClause(ri).clause;
           int rl = 0, ul = mrk - 1;
 
           for (int j = 0; j < rc.size(); j++) {
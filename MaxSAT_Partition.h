@@ -123,10 +123,10 @@ protected:
   Graph *buildCVIGGraph(bool weighted);
   Graph *buildRESGraph(bool weighted);
 
-  int unassignedLiterals(vec<Lit> &sc);
+  int unassignedLiterals(const ClauseLits &sc);
   bool isUnsatisfied(vec<Lit> &sc);
 
-  int markUnassignedLiterals(vec<Lit> &c, int *markedLits, bool v);
+  int markUnassignedLiterals(const ClauseLits &c, int *markedLits, bool v);
 
   void printClause(vec<Lit> &sc);
 
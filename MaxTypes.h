@@ -28,11 +28,13 @@
 #ifndef MaxTypes_h
 #define MaxTypes_h
 
+#include <chrono>
 #include <sstream>
 
 namespace openwbo {
 
 #define _MAX_CLAUSES_ 3000000
+#define _MAX_CACHED_LITS_ 10000000
 
 /** This class catches the exception that is used across the solver to indicate errors */
 class MaxSATException
@@ -46,6 +48,19 @@ public:
   const char* getMsg() const {return s.str().c_str();}
 };
 
+/** This exception unwinds the search of a solver that has been interrupted */
+class MaxSATInterrupt
+{
+};
+
+// Wall-clock time in seconds, measured by Open-WBO itself since not every SAT
+// solver backend provides one.
+static inline double wallClockTime() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
 enum { _FORMAT_MAXSAT_ = 0, _FORMAT_PB_ };
 enum { _VERBOSITY_MINIMAL_ = 0, _VERBOSITY_SOME_ };
 enum { _UNWEIGHTED_ = 0, _WEIGHTED_ };
@@ -56,7 +71,8 @@ enum {
   _ALGORITHM_MSU3_,
   _ALGORITHM_PART_MSU3_,
   _ALGORITHM_OLL_,
-  _ALGORITHM_BEST_
+  _ALGORITHM_BEST_,
+  _ALGORITHM_PORTFOLIO_
 };
 enum StatusCode {
   _SATISFIABLE_ = 10,
@@ -71,9 +87,15 @@ enum {
   _INCREMENTAL_WEAKENING_,
   _INCREMENTAL_ITERATIVE_
 };
-enum { _CARD_CNETWORKS_ = 0, _CARD_TOTALIZER_, _CARD_MTOTALIZER_ };
+enum {
+  _CARD_CNETWORKS_ = 0,
+  _CARD_TOTALIZER_,
+  _CARD_MTOTALIZER_,
+  _CARD_ADDER_,
+  _CARD_AUTO_
+};
 enum { _AMO_LADDER_ = 0 };
-enum { _PB_SWC_ = 0, _PB_GTE_, _PB_ADDER_ };
+enum { _PB_SWC_ = 0, _PB_GTE_, _PB_ADDER_, _PB_AUTO_ };
 enum { _PART_SEQUENTIAL_ = 0, _PART_SEQUENTIAL_SORTED_, _PART_BINARY_ };
 
 }
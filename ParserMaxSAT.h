@@ -30,7 +30,15 @@
 #ifndef ParserMaxSAT_h
 #define ParserMaxSAT_h
 
+#include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
 
 #include "MaxSATFormula.h"
 #include "core/SolverTypes.h"
@@ -60,15 +68,9 @@ template <class B> static uint64_t parseWeight(B &in) {
 }
 
 template <class B, class MaxSATFormula>
-static uint64_t readClause(B &in, MaxSATFormula *maxsat_formula,
-                           vec<Lit> &lits) {
+static void readLits(B &in, MaxSATFormula *maxsat_formula, vec<Lit> &lits) {
   int parsed_lit, var;
-  int64_t weight = 1;
   lits.clear();
-  if (maxsat_formula->getProblemType() == _WEIGHTED_)
-    weight = parseWeight(in);
-  assert(weight > 0);
-
   for (;;) {
     parsed_lit = parseInt(in);
     if (parsed_lit == 0)
@@ -78,18 +80,36 @@ static uint64_t readClause(B &in, MaxSATFormula *maxsat_formula,
       maxsat_formula->newVar();
     lits.push((parsed_lit > 0) ? mkLit(var) : ~mkLit(var));
   }
+}
+
+template <class B, class MaxSATFormula>
+static uint64_t readClause(B &in, MaxSATFormula *maxsat_formula,
+                           vec<Lit> &lits) {
+  int64_t weight = 1;
+  if (maxsat_formula->getProblemType() == _WEIGHTED_)
+    weight = parseWeight(in);
+  assert(weight > 0);
+
+  readLits(in, maxsat_formula, lits);
   return weight;
 }
 
+// Parses both the legacy format ('p wcnf nvars nclauses top' header, hard
+// clauses have weight >= top) and the headerless format of the MaxSAT
+// Evaluation 2022+ (hard clauses are prefixed with 'h' and every other clause
+// starts with its weight). A file without a 'p' line before its first clause
+// is read in the new format.
 template <class B, class MaxSATFormula>
 static void parseMaxSAT(B &in, MaxSATFormula *maxsat_formula) {
   vec<Lit> lits;
   uint64_t hard_weight = UINT64_MAX;
+  bool header = false;
   for (;;) {
     skipWhitespace(in);
     if (*in == EOF)
       break;
     else if (*in == 'p') {
+      header = true;
       if (eagerMatch(in, "p cnf")) {
         parseInt(in); // Variables
         parseInt(in); // Clauses
@@ -107,6 +127,19 @@ static void parseMaxSAT(B &in, MaxSATFormula *maxsat_formula) {
     } else if (*in == 'c' || *in == 'p')
       skipLine(in);
     else {
+      if (!header) {
+        // New format: every soft clause has a weight.
+        maxsat_formula->setProblemType(_WEIGHTED_);
+        header = true;
+      }
+
+      if (*in == 'h') {
+        ++in;
+        readLits(in, maxsat_formula, lits);
+        maxsat_formula->addHardClause(lits);
+        continue;
+      }
+
       uint64_t weight = readClause(in, maxsat_formula, lits);
       if (weight < hard_weight ||
           maxsat_formula->getProblemType() == _UNWEIGHTED_) {
@@ -137,6 +170,257 @@ static void parseMaxSATFormula(gzFile input_stream,
   // maxsat_formula->setInitialVars(maxsat_formula->nVars());
 }
 
+//=================================================================================================
+// Parallel DIMACS Parser:
+//
+// Uncompressed files are memory-mapped and split into chunks at clause
+// boundaries. Each thread parses one chunk into its own clause buffer and the
+// buffers are merged in file order, so the resulting formula is identical to
+// the one produced by 'parseMaxSATFormula'.
+
+// Clauses parsed by one thread of the parallel parser.
+struct ParsedChunk {
+  std::vector<Lit> lits;         // Literals of all clauses of the chunk.
+  std::vector<int> sizes;        // Number of literals of each clause.
+  std::vector<uint64_t> weights; // Weight of each clause ('h' is UINT64_MAX).
+  int max_var;                   // Largest variable of the chunk.
+  bool failed;                   // True if the chunk could not be parsed.
+  int error;                     // Unexpected char, or EOF at end of input.
+
+  ParsedChunk() : max_var(-1), failed(false), error(0) {}
+};
+
+static inline bool isSpace(char c) { return (c >= 9 && c <= 13) || c == 32; }
+
+// Returns true if the line that ends right before 'pos' terminates a clause.
+static bool endsClause(const char *begin, const char *pos) {
+  const char *q = pos - 1;
+  while (q > begin && isSpace(q[-1]))
+    q--;
+  if (q == begin || q[-1] != '0')
+    return false;
+  q--; // 'q' points to the last token, which must be exactly "0".
+  return q == begin || isSpace(q[-1]);
+}
+
+// Parses the clauses in [begin, end) into 'chunk'.
+static void parseChunk(const char *begin, const char *end, bool weighted,
+                       ParsedChunk *chunk) {
+  const char *in = begin;
+  for (;;) {
+    while (in < end && isSpace(*in))
+      ++in;
+    if (in == end)
+      break;
+
+    if (*in == 'c' || *in == 'p') {
+      while (in < end && *in != '\n')
+        ++in;
+      continue;
+    }
+
+    uint64_t weight = 1;
+    if (*in == 'h') {
+      weight = UINT64_MAX;
+      ++in;
+    } else if (weighted) {
+      if (*in < '0' || *in > '9') {
+        chunk->failed = true;
+        chunk->error = (unsigned char)*in;
+        return;
+      }
+      weight = 0;
+      while (in < end && *in >= '0' && *in <= '9')
+        weight = weight * 10 + (*in - '0'), ++in;
+    }
+
+    int size = 0;
+    for (;;) {
+      while (in < end && isSpace(*in))
+        ++in;
+      if (in == end) {
+        chunk->failed = true;
+        chunk->error = EOF;
+        return;
+      }
+      bool neg = false;
+      if (*in == '-')
+        neg = true, ++in;
+      else if (*in == '+')
+        ++in;
+      if (in == end || *in < '0' || *in > '9') {
+        chunk->failed = true;
+        chunk->error = (in == end) ? EOF : (unsigned char)*in;
+        return;
+      }
+      int parsed_lit = 0;
+      while (in < end && *in >= '0' && *in <= '9')
+        parsed_lit = parsed_lit * 10 + (*in - '0'), ++in;
+      if (parsed_lit == 0)
+        break;
+      int var = parsed_lit - 1;
+      if (var > chunk->max_var)
+        chunk->max_var = var;
+      chunk->lits.push_back(neg ? ~mkLit(var) : mkLit(var));
+      size++;
+    }
+
+    assert(weight > 0);
+    chunk->sizes.push_back(size);
+    chunk->weights.push_back(weight);
+  }
+}
+
+// Parses 'file' with 'nb_threads' threads. Returns false if the file cannot be
+// memory-mapped or is compressed, in which case the caller should fall back to
+// 'parseMaxSATFormula'.
+template <class MaxSATFormula>
+static bool parseMaxSATFormulaParallel(const char *file,
+                                       MaxSATFormula *maxsat_formula,
+                                       int nb_threads) {
+  int fd = open(file, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 2) {
+    close(fd);
+    return false;
+  }
+
+  size_t length = st.st_size;
+  void *data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+
+  const char *begin = (const char *)data;
+  const char *end = begin + length;
+
+  // gzip magic number.
+  if ((unsigned char)begin[0] == 0x1f && (unsigned char)begin[1] == 0x8b) {
+    munmap(data, length);
+    return false;
+  }
+
+  // The header is parsed sequentially.
+  uint64_t hard_weight = UINT64_MAX;
+  bool header = false;
+  const char *in = begin;
+  for (;;) {
+    while (in < end && isSpace(*in))
+      ++in;
+    if (in == end || (*in != 'c' && *in != 'p'))
+      break;
+    if (*in == 'p') {
+      char line[256];
+      int i = 0;
+      while (in + i < end && in[i] != '\n' && i < 255)
+        line[i] = in[i], i++;
+      line[i] = '\0';
+
+      unsigned long long top = 0;
+      header = true;
+      if (strncmp(line, "p cnf", 5) == 0)
+        ;
+      else if (strncmp(line, "p wcnf", 6) == 0) {
+        maxsat_formula->setProblemType(_WEIGHTED_);
+        int vars, clauses;
+        if (sscanf(line, "p wcnf %d %d %llu", &vars, &clauses, &top) == 3) {
+          hard_weight = top;
+          maxsat_formula->setHardWeight(hard_weight);
+        }
+      } else
+        printf("c PARSE ERROR! Unexpected char: %c\n", line[2]),
+            printf("s UNKNOWN\n"), exit(_ERROR_);
+    }
+    while (in < end && *in != '\n')
+      ++in;
+  }
+  // New format: every soft clause has a weight.
+  if (!header)
+    maxsat_formula->setProblemType(_WEIGHTED_);
+  bool weighted = maxsat_formula->getProblemType() == _WEIGHTED_;
+
+  // Split the remaining of the file at clause boundaries.
+  std::vector<const char *> bounds;
+  bounds.push_back(in);
+  size_t body = end - in;
+  for (int t = 1; t < nb_threads; t++) {
+    const char *pos = in + body / nb_threads * t;
+    if (pos < bounds.back())
+      pos = bounds.back();
+    while (pos < end) {
+      pos = (const char *)memchr(pos, '\n', end - pos);
+      if (pos == NULL) {
+        pos = end;
+        break;
+      }
+      pos++;
+      if (endsClause(bounds.back(), pos))
+        break;
+    }
+    bounds.push_back(pos);
+  }
+  bounds.push_back(end);
+
+  std::vector<ParsedChunk> chunks(nb_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nb_threads; t++)
+    threads.push_back(std::thread(parseChunk, bounds[t], bounds[t + 1],
+                                  weighted, &chunks[t]));
+  for (int t = 0; t < nb_threads; t++)
+    threads[t].join();
+
+  munmap(data, length);
+
+  int max_var = -1;
+  for (int t = 0; t < nb_threads; t++) {
+    if (chunks[t].failed) {
+      if (chunks[t].error == EOF)
+        fprintf(stderr, "PARSE ERROR! Unexpected end of input\n");
+      else
+        fprintf(stderr, "PARSE ERROR! Unexpected char: %c (%d)\n",
+                chunks[t].error, chunks[t].error);
+      exit(3);
+    }
+    if (chunks[t].max_var > max_var)
+      max_var = chunks[t].max_var;
+  }
+  while (max_var >= maxsat_formula->nVars())
+    maxsat_formula->newVar();
+
+  // Merge the clauses in file order.
+  vec<Lit> lits;
+  for (int t = 0; t < nb_threads; t++) {
+    ParsedChunk &chunk = chunks[t];
+    size_t pos = 0;
+    for (size_t c = 0; c < chunk.sizes.size(); c++) {
+      lits.clear();
+      for (int j = 0; j < chunk.sizes[c]; j++)
+        lits.push(chunk.lits[pos++]);
+
+      uint64_t weight = chunk.weights[c];
+      if (weight != UINT64_MAX && (weight < hard_weight || !weighted)) {
+        // Updates the maximum weight of soft clauses.
+        maxsat_formula->setMaximumWeight(weight);
+        // Updates the sum of the weights of soft clauses.
+        maxsat_formula->updateSumWeights(weight);
+        maxsat_formula->addSoftClause(weight, lits);
+      } else
+        maxsat_formula->addHardClause(lits);
+    }
+    std::vector<Lit>().swap(chunk.lits);
+  }
+
+  if (maxsat_formula->getMaximumWeight() == 1)
+    maxsat_formula->setProblemType(_UNWEIGHTED_);
+  else
+    maxsat_formula->setProblemType(_WEIGHTED_);
+
+  return true;
+}
+
 //=================================================================================================
 } // namespace openwbo
 
@@ -0,0 +1,580 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Preprocessor.h"
+
+#include "mtl/Sort.h"
+#include "utils/System.h"
+#include <algorithm>
+
+using namespace openwbo;
+
+using NSPACE::toLit;
+using NSPACE::cpuTime;
+
+// Candidates of a clause in subsumption are only searched in occurrence lists
+// up to this size.
+#define SUBSUMPTION_LIMIT 1000
+// Variables with more occurrences of both polarities are not eliminated.
+#define ELIM_OCCURS_LIMIT 10
+// Resolvents larger than this stop the elimination of a variable.
+#define ELIM_CLAUSE_LIMIT 20
+
+Preprocessor::Preprocessor(MaxSATFormula *mx)
+    : formula(mx), supported(true), nbVars(mx->nVars()), qhead(0),
+      preprocessTime(0), nbFixedVars(0), nbEliminatedVars(0), nbSubsumed(0),
+      nbLabels(0), nbMerged(0) {
+
+  if (mx->getFormat() != _FORMAT_MAXSAT_ || mx->nCard() > 0 ||
+      mx->nPB() > 0 || mx->getObjFunction() != NULL)
+    supported = false;
+}
+
+// Adds a clause with weight 'w' (0 for hard clauses). Duplicate literals are
+// removed and tautologies are not added. Returns false if 'lits' is an empty
+// hard clause.
+bool Preprocessor::addClause(vec<Lit> &lits, uint64_t w) {
+  sort(lits);
+  int i, j;
+  Lit p = lit_Undef;
+  for (i = j = 0; i < lits.size(); i++) {
+    if (lits[i] == ~p)
+      return true;
+    else if (lits[i] != p)
+      lits[j++] = p = lits[i];
+  }
+  lits.shrink(i - j);
+
+  if (lits.size() == 0 && w == 0)
+    return false;
+
+  int c = clauses.size();
+  clauses.push();
+  lits.copyTo(clauses[c]);
+  weight.push(w);
+  removed.push(false);
+  for (int k = 0; k < lits.size(); k++)
+    occurs[toInt(lits[k])].push(c);
+
+  if (lits.size() == 1 && w == 0)
+    return enqueue(lits[0]);
+  return true;
+}
+
+// Removes clause 'c'. Occurrence lists are cleaned lazily.
+void Preprocessor::removeClause(int c) {
+  assert(!removed[c]);
+  removed[c] = true;
+  clauses[c].clear(true);
+}
+
+// Fixes 'p' to true. Returns false if 'p' is already false.
+bool Preprocessor::enqueue(Lit p) {
+  if (assigns[var(p)] != l_Undef)
+    return assigns[var(p)] == lbool(!sign(p));
+  assigns[var(p)] = lbool(!sign(p));
+  trail.push(p);
+  return true;
+}
+
+// Collects the clauses that are in the formula and contain 'p'.
+void Preprocessor::collectOccurrences(Lit p, vec<int> &live) {
+  live.clear();
+  vec<int> &occs = occurs[toInt(p)];
+  int i, j;
+  for (i = j = 0; i < occs.size(); i++)
+    if (!removed[occs[i]])
+      occs[j++] = occs[i];
+  occs.shrink(i - j);
+  occs.copyTo(live);
+}
+
+// Stores clause 'lits' of the removed variable 'v' for 'reconstruct'.
+void Preprocessor::addElimClause(Var v, vec<Lit> &lits) {
+  int first = elimclauses.size();
+  int v_pos = -1;
+  for (int i = 0; i < lits.size(); i++) {
+    elimclauses.push(toInt(lits[i]));
+    if (var(lits[i]) == v)
+      v_pos = i + first;
+  }
+  assert(v_pos != -1);
+
+  // Swap the first literal with the literal of 'v'.
+  uint32_t tmp = elimclauses[v_pos];
+  elimclauses[v_pos] = elimclauses[first];
+  elimclauses[first] = tmp;
+
+  elimclauses.push(lits.size());
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  propagate : [void] ->  [bool]
+  |
+  |  Description:
+  |
+  |    Unit propagation of the hard clauses. Satisfied clauses are removed and
+  |    false literals are removed from the remaining clauses. A soft clause
+  |    keeps its last literal when all of its literals are false, so that its
+  |    weight is still counted in the cost.
+  |
+  |  Post-conditions:
+  |    * Returns false if a hard clause is falsified.
+  |
+  |________________________________________________________________________________________________@*/
+bool Preprocessor::propagate() {
+  vec<Lit> unit;
+  while (qhead < trail.size()) {
+    Lit p = trail[qhead++];
+    unit.clear();
+    unit.push(p);
+    addElimClause(var(p), unit);
+    nbFixedVars++;
+
+    vec<int> &sat = occurs[toInt(p)];
+    for (int i = 0; i < sat.size(); i++)
+      if (!removed[sat[i]])
+        removeClause(sat[i]);
+    sat.clear(true);
+
+    vec<int> &unsat = occurs[toInt(~p)];
+    for (int i = 0; i < unsat.size(); i++) {
+      int c = unsat[i];
+      if (removed[c] || (isSoft(c) && clauses[c].size() == 1))
+        continue;
+
+      vec<Lit> &lits = clauses[c];
+      int j = 0;
+      while (lits[j] != ~p)
+        j++;
+      for (; j < lits.size() - 1; j++)
+        lits[j] = lits[j + 1];
+      lits.pop();
+
+      if (!isSoft(c)) {
+        if (lits.size() == 0 || (lits.size() == 1 && !enqueue(lits[0])))
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  subsume : [void] ->  [void]
+  |
+  |  Description:
+  |
+  |    Removes the clauses that are subsumed by a hard clause. A subsumed soft
+  |    clause is satisfied by every model of the hard clauses.
+  |
+  |________________________________________________________________________________________________@*/
+void Preprocessor::subsume() {
+  vec<int> order;
+  for (int c = 0; c < clauses.size(); c++)
+    if (!removed[c] && !isSoft(c))
+      order.push(c);
+  std::sort((int *)order, (int *)order + order.size(), [this](int a, int b) {
+    return clauses[a].size() < clauses[b].size();
+  });
+
+  vec<int> candidates;
+  for (int i = 0; i < order.size(); i++) {
+    int c = order[i];
+    if (removed[c])
+      continue;
+    vec<Lit> &lits = clauses[c];
+
+    // The candidates are the clauses with the least frequent literal of 'c'.
+    Lit best = lits[0];
+    for (int j = 1; j < lits.size(); j++)
+      if (occurs[toInt(lits[j])].size() < occurs[toInt(best)].size())
+        best = lits[j];
+    if (occurs[toInt(best)].size() > SUBSUMPTION_LIMIT)
+      continue;
+    collectOccurrences(best, candidates);
+
+    for (int j = 0; j < lits.size(); j++)
+      seen[toInt(lits[j])] = 1;
+
+    for (int j = 0; j < candidates.size(); j++) {
+      int d = candidates[j];
+      if (d == c || removed[d] || clauses[d].size() < lits.size())
+        continue;
+      int found = 0;
+      for (int k = 0; k < clauses[d].size(); k++)
+        found += seen[toInt(clauses[d][k])];
+      if (found == lits.size()) {
+        removeClause(d);
+        nbSubsumed++;
+      }
+    }
+
+    for (int j = 0; j < lits.size(); j++)
+      seen[toInt(lits[j])] = 0;
+  }
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  detectLabels : [void] ->  [void]
+  |
+  |  Description:
+  |
+  |    A soft clause (-b) is the label of a hard clause (C v b) when 'b' does
+  |    not occur anywhere else: the two clauses are then replaced by the soft
+  |    clause C with the same weight. The variable of 'b' is removed and gets
+  |    the value that falsifies it unless C is falsified.
+  |
+  |________________________________________________________________________________________________@*/
+void Preprocessor::detectLabels() {
+  vec<int> pos, neg;
+  vec<Lit> lits;
+  int nbClauses = clauses.size();
+  for (int s = 0; s < nbClauses; s++) {
+    if (removed[s] || !isSoft(s) || clauses[s].size() != 1)
+      continue;
+    Lit l = clauses[s][0];
+    if (assigns[var(l)] != l_Undef)
+      continue;
+
+    collectOccurrences(l, pos);
+    collectOccurrences(~l, neg);
+    if (pos.size() != 1 || neg.size() != 1 || isSoft(neg[0]))
+      continue;
+
+    int h = neg[0];
+    addElimClause(var(l), clauses[h]);
+    lits.clear();
+    lits.push(l);
+    addElimClause(var(l), lits);
+
+    lits.clear();
+    for (int i = 0; i < clauses[h].size(); i++)
+      if (clauses[h][i] != ~l)
+        lits.push(clauses[h][i]);
+
+    uint64_t w = weight[s];
+    removeClause(s);
+    removeClause(h);
+    addClause(lits, w);
+    eliminated[var(l)] = true;
+    nbLabels++;
+  }
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  mergeSoftClauses : [void] ->  [void]
+  |
+  |  Description:
+  |
+  |    Replaces soft clauses with the same literals by a single soft clause
+  |    with the sum of their weights. Unweighted formulas are left unchanged
+  |    since the result would be a weighted formula.
+  |
+  |________________________________________________________________________________________________@*/
+void Preprocessor::mergeSoftClauses() {
+  if (formula->getProblemType() == _UNWEIGHTED_)
+    return;
+
+  vec<int> softs;
+  for (int c = 0; c < clauses.size(); c++)
+    if (!removed[c] && isSoft(c))
+      softs.push(c);
+
+  // Literals are sorted in each clause.
+  std::sort((int *)softs, (int *)softs + softs.size(), [this](int a, int b) {
+    vec<Lit> &x = clauses[a], &y = clauses[b];
+    if (x.size() != y.size())
+      return x.size() < y.size();
+    for (int i = 0; i < x.size(); i++)
+      if (x[i] != y[i])
+        return x[i] < y[i];
+    return false;
+  });
+
+  for (int i = 0, j = 1; j < softs.size(); j++) {
+    vec<Lit> &x = clauses[softs[i]], &y = clauses[softs[j]];
+    bool same = x.size() == y.size();
+    for (int k = 0; same && k < x.size(); k++)
+      same = x[k] == y[k];
+
+    // The sum must remain lower than the weight of the hard clauses.
+    if (same && weight[softs[j]] < formula->getHardWeight() - weight[softs[i]]) {
+      weight[softs[i]] += weight[softs[j]];
+      removeClause(softs[j]);
+      nbMerged++;
+    } else
+      i = j;
+  }
+}
+
+// Resolves 'pos' and 'neg' on 'v' into 'out'. Returns false if the resolvent
+// is a tautology.
+bool Preprocessor::resolve(vec<Lit> &pos, vec<Lit> &neg, Var v,
+                           vec<Lit> &out) {
+  out.clear();
+  for (int i = 0; i < pos.size(); i++)
+    if (var(pos[i]) != v) {
+      seen[toInt(pos[i])] = 1;
+      out.push(pos[i]);
+    }
+
+  bool tautology = false;
+  for (int i = 0; i < neg.size() && !tautology; i++) {
+    if (var(neg[i]) == v || seen[toInt(neg[i])])
+      continue;
+    if (seen[toInt(~neg[i])])
+      tautology = true;
+    else
+      out.push(neg[i]);
+  }
+
+  for (int i = 0; i < pos.size(); i++)
+    seen[toInt(pos[i])] = 0;
+  return !tautology;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  eliminate : (v : Var) ->  [bool]
+  |
+  |  Description:
+  |
+  |    Bounded variable elimination of 'v': the clauses with 'v' are replaced
+  |    by their resolvents if there are not more resolvents than clauses.
+  |    The variable must not occur in soft clauses.
+  |
+  |  Post-conditions:
+  |    * Returns false if an empty resolvent was found.
+  |
+  |________________________________________________________________________________________________@*/
+bool Preprocessor::eliminate(Var v) {
+  vec<int> pos, neg;
+  collectOccurrences(mkLit(v), pos);
+  collectOccurrences(~mkLit(v), neg);
+  if (pos.size() + neg.size() == 0 ||
+      (pos.size() > ELIM_OCCURS_LIMIT && neg.size() > ELIM_OCCURS_LIMIT))
+    return true;
+
+  for (int i = 0; i < pos.size(); i++)
+    if (isSoft(pos[i]))
+      return true;
+  for (int i = 0; i < neg.size(); i++)
+    if (isSoft(neg[i]))
+      return true;
+
+  vec<vec<Lit> > resolvents;
+  vec<Lit> resolvent;
+  for (int i = 0; i < pos.size(); i++)
+    for (int j = 0; j < neg.size(); j++) {
+      if (!resolve(clauses[pos[i]], clauses[neg[j]], v, resolvent))
+        continue;
+      if (resolvents.size() == pos.size() + neg.size() ||
+          resolvent.size() > ELIM_CLAUSE_LIMIT)
+        return true;
+      resolvents.push();
+      resolvent.copyTo(resolvents.last());
+    }
+
+  // The clauses of the least frequent polarity are kept for reconstruction,
+  // the other polarity is the default value.
+  vec<int> &kept = pos.size() > neg.size() ? neg : pos;
+  for (int i = 0; i < kept.size(); i++)
+    addElimClause(v, clauses[kept[i]]);
+  resolvent.clear();
+  resolvent.push(pos.size() > neg.size() ? mkLit(v) : ~mkLit(v));
+  addElimClause(v, resolvent);
+
+  for (int i = 0; i < pos.size(); i++)
+    removeClause(pos[i]);
+  for (int i = 0; i < neg.size(); i++)
+    removeClause(neg[i]);
+  occurs[toInt(mkLit(v))].clear(true);
+  occurs[toInt(~mkLit(v))].clear(true);
+  eliminated[v] = true;
+  nbEliminatedVars++;
+
+  for (int i = 0; i < resolvents.size(); i++)
+    if (!addClause(resolvents[i], 0))
+      return false;
+  return true;
+}
+
+// Eliminates the variables that do not occur in soft clauses, starting with
+// the ones with fewer occurrences. Returns false if a conflict was found.
+bool Preprocessor::eliminateVariables() {
+  vec<int> order;
+  for (int v = 0; v < nbVars; v++)
+    if (assigns[v] == l_Undef && !eliminated[v])
+      order.push(v);
+  std::sort((int *)order, (int *)order + order.size(), [this](int a, int b) {
+    return occurs[toInt(mkLit(a))].size() + occurs[toInt(~mkLit(a))].size() <
+           occurs[toInt(mkLit(b))].size() + occurs[toInt(~mkLit(b))].size();
+  });
+
+  for (int i = 0; i < order.size(); i++) {
+    if (assigns[order[i]] != l_Undef)
+      continue;
+    if (!eliminate(order[i]) || !propagate())
+      return false;
+  }
+  return true;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  simplify : [void] ->  [MaxSATFormula *]
+  |
+  |  Description:
+  |
+  |    Simplifies the formula and returns a new formula with the same
+  |    variables. Variables that were fixed and still occur in soft clauses
+  |    are fixed by unit hard clauses in the new formula.
+  |
+  |  Pre-conditions:
+  |    * The formula is supported (see 'isSupported').
+  |
+  |  Post-conditions:
+  |    * Returns NULL if the hard clauses are unsatisfiable.
+  |
+  |________________________________________________________________________________________________@*/
+MaxSATFormula *Preprocessor::simplify() {
+  assert(supported);
+  double start = cpuTime();
+
+  occurs.growTo(2 * nbVars);
+  seen.growTo(2 * nbVars, 0);
+  assigns.growTo(nbVars, l_Undef);
+  eliminated.growTo(nbVars, false);
+
+  vec<Lit> lits;
+  for (int i = 0; i < formula->nHard(); i++) {
+    formula->getHardClause(i).clause.copyTo(lits);
+    if (!addClause(lits, 0))
+      return NULL;
+  }
+  for (int i = 0; i < formula->nSoft(); i++) {
+    formula->getSoftClause(i).clause.copyTo(lits);
+    addClause(lits, formula->getSoftClause(i).weight);
+  }
+
+  if (!propagate())
+    return NULL;
+  subsume();
+  detectLabels();
+  mergeSoftClauses();
+  if (!eliminateVariables())
+    return NULL;
+
+  MaxSATFormula *mx = new MaxSATFormula();
+  mx->newVar(nbVars);
+  mx->setFormat(_FORMAT_MAXSAT_);
+  mx->setHardWeight(formula->getHardWeight());
+
+  for (int c = 0; c < clauses.size(); c++)
+    if (!removed[c] && !isSoft(c)) {
+      clauses[c].copyTo(lits);
+      mx->addHardClause(lits);
+    }
+
+  for (int c = 0; c < clauses.size(); c++) {
+    if (removed[c] || !isSoft(c))
+      continue;
+    // Soft clauses falsified by unit propagation.
+    if (clauses[c].size() == 1 && assigns[var(clauses[c][0])] != l_Undef &&
+        !seen[toInt(clauses[c][0])]) {
+      seen[toInt(clauses[c][0])] = 1;
+      lits.clear();
+      lits.push(~clauses[c][0]);
+      mx->addHardClause(lits);
+    }
+    clauses[c].copyTo(lits);
+    mx->setMaximumWeight(weight[c]);
+    mx->updateSumWeights(weight[c]);
+    mx->addSoftClause(weight[c], lits);
+  }
+
+  if (mx->getMaximumWeight() == 1)
+    mx->setProblemType(_UNWEIGHTED_);
+  else
+    mx->setProblemType(_WEIGHTED_);
+
+  preprocessTime = cpuTime() - start;
+  return mx;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  reconstruct : (model : vec<lbool>&) ->  [void]
+  |
+  |  Description:
+  |
+  |    Sets the values of the removed variables from the stored clauses, in
+  |    the reverse order of their removal (see 'Solver::extendModel').
+  |
+  |________________________________________________________________________________________________@*/
+void Preprocessor::reconstruct(vec<lbool> &model) {
+  int i, j;
+  Lit x;
+
+  for (i = elimclauses.size() - 1; i > 0; i -= j) {
+    for (j = elimclauses[i--]; j > 1; j--, i--) {
+      Lit p = toLit(elimclauses[i]);
+      if ((model[var(p)] ^ sign(p)) != l_False)
+        goto next;
+    }
+
+    x = toLit(elimclauses[i]);
+    model[var(x)] = lbool(!sign(x));
+  next:;
+  }
+}
+
+void Preprocessor::printStats() {
+  printf("c |  Preprocess time:      %12.2f s                                "
+         "                                 |\n",
+         preprocessTime);
+  printf("c |  Fixed variables:      %12d                                    "
+         "                               |\n",
+         nbFixedVars);
+  printf("c |  Eliminated variables: %12d                                    "
+         "                               |\n",
+         nbEliminatedVars);
+  printf("c |  Subsumed clauses:     %12d                                    "
+         "                               |\n",
+         nbSubsumed);
+  printf("c |  Labels:               %12d                                    "
+         "                               |\n",
+         nbLabels);
+  printf("c |  Merged soft clauses:  %12d                                    "
+         "                               |\n",
+         nbMerged);
+}
@@ -0,0 +1,135 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef Preprocessor_h
+#define Preprocessor_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include "MaxSATFormula.h"
+#include <stdint.h>
+
+using NSPACE::vec;
+using NSPACE::Lit;
+using NSPACE::Var;
+using NSPACE::lbool;
+
+namespace openwbo {
+
+/** Simplification of a MaxSAT formula before the search.
+ *
+ *  The following techniques are applied, in this order:
+ *  - unit propagation of the hard clauses;
+ *  - subsumption of hard and soft clauses by hard clauses;
+ *  - label detection: a soft clause (-b) whose variable only occurs in one
+ *    hard clause (C v b) is replaced by the soft clause C;
+ *  - merging of duplicate soft clauses (weighted formulas only);
+ *  - bounded variable elimination of the variables that do not occur in
+ *    soft clauses.
+ *
+ *  The simplified formula keeps the variables of the original formula and has
+ *  the same optimum cost. The values of the removed variables are set by
+ *  'reconstruct' from the clauses they were removed with, as in the variable
+ *  elimination of MiniSat. Only formulas made of clauses are supported.
+ */
+class Preprocessor {
+
+public:
+  Preprocessor(MaxSATFormula *mx);
+
+  // False if the formula has cardinality or pseudo-Boolean constraints.
+  bool isSupported() { return supported; }
+
+  // Returns the simplified formula, or NULL if the hard clauses were found
+  // to be unsatisfiable (the original formula is then solved as it is).
+  MaxSATFormula *simplify();
+
+  // Sets the variables removed by 'simplify' in 'model', a model of the
+  // simplified formula, so that it becomes a model of the original one.
+  void reconstruct(vec<lbool> &model);
+
+  MaxSATFormula *getFormula() { return formula; }
+
+  void printStats();
+
+protected:
+  bool addClause(vec<Lit> &lits, uint64_t w);
+  void removeClause(int c);
+  bool enqueue(Lit p);
+
+  // Simplification techniques (false if a conflict was found)
+  bool propagate();
+  void subsume();
+  void detectLabels();
+  void mergeSoftClauses();
+  bool eliminateVariables();
+
+  bool eliminate(Var v);
+  bool resolve(vec<Lit> &pos, vec<Lit> &neg, Var v, vec<Lit> &out);
+  void collectOccurrences(Lit p, vec<int> &live);
+  void addElimClause(Var v, vec<Lit> &lits);
+
+  bool isSoft(int c) { return weight[c] != 0; }
+
+  MaxSATFormula *formula; // Original formula.
+  bool supported;
+  int nbVars;
+
+  // Clauses (copied from the formula)
+  vec<vec<Lit> > clauses;  // Literals of each clause (sorted).
+  vec<uint64_t> weight;    // Weight of each clause (0 for hard clauses).
+  vec<bool> removed;       // Clauses that are no longer in the formula.
+  vec<vec<int> > occurs;   // Clauses where each literal occurs (may contain
+                           // removed clauses).
+
+  vec<lbool> assigns;      // Values fixed by unit propagation.
+  vec<Lit> trail;          // Literals fixed by unit propagation.
+  int qhead;               // Next literal of 'trail' to propagate.
+  vec<bool> eliminated;    // Variables removed by elimination or labels.
+  vec<char> seen;          // Marks literals (indexed by 'toInt').
+
+  // Clauses of the removed variables in the format of MiniSat: the literals
+  // of each clause, with the literal of the removed variable first, followed
+  // by the size of the clause.
+  vec<uint32_t> elimclauses;
+
+  // Statistics
+  double preprocessTime;
+  int nbFixedVars;
+  int nbEliminatedVars;
+  int nbSubsumed;
+  int nbLabels;
+  int nbMerged;
+};
+
+} // namespace openwbo
+
+#endif
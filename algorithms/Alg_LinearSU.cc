@@ -27,8 +27,15 @@
 
 #include "Alg_LinearSU.h"
 
+#include <float.h>
+
 using namespace openwbo;
 
+// Conflicts of each SAT call between two checks of the deadline.
+#define ANYTIME_CONFLICTS 10000
+// Factor between two consecutive weight resolutions of the anytime search.
+#define ANYTIME_RESOLUTION 10
+
 /************************************************************************************************
  //
  // Linear Search Algorithm with Boolean Multilevel Optimization (BMO)
@@ -42,6 +49,8 @@ using namespace openwbo;
   |  Description:
   |
   |    Linear search algorithm with lexicographical optimization.
+  |    A single SAT solver is used for all lexicographical functions so that
+  |    learnt clauses are kept between them.
   |
   |  For further details see:
   |    * Joao Marques-Silva, Josep Argelich, Ana Graça, Ines Lynce: Boolean
@@ -65,21 +74,26 @@ StatusCode LinearSU::bmoSearch() {
   uint64_t minWeight = orderWeights[orderWeights.size() - 1];
   int posWeight = 0;
 
-  vec<vec<Lit>> functions;
-  vec<int> weights;
+  // The same solver is used for all lexicographical functions. It starts with
+  // the soft clauses of the first function and the soft clauses of the next
+  // function are added once the current one is optimized.
+  solver = rebuildSolver(currentWeight);
+  addBMOFunction(currentWeight);
 
-  solver = rebuildBMO(functions, weights, currentWeight);
+  // Contains the literal that tightens the bound of the current function.
+  vec<Lit> assumptions;
 
   uint64_t localCost = 0;
   ubCost = 0;
 
   for (;;) {
 
-    vec<Lit> dummy;
     // Do not use preprocessing for linear search algorithm.
     // NOTE: When preprocessing is enabled the SAT solver simplifies the
     // relaxation variables which leads to incorrect results.
-    res = searchSATSolver(solver, dummy);
+    res = solveUntil(solver, deadline, assumptions);
+    if (res == l_Undef)
+      return deadlineAnswer();
 
     if (res == l_True) {
       nbSatisfiable++;
@@ -106,30 +120,37 @@ StatusCode LinearSU::bmoSearch() {
 
         if (newCost == 0) {
 
-          functions.push();
-          new (&functions[functions.size() - 1]) vec<Lit>();
-          objFunction.copyTo(functions[functions.size() - 1]);
-
-          localCost = newCost;
-          weights.push(localCost / currentWeight);
+          // The optimum of the current function is 0.
+          for (int i = 0; i < objFunction.size(); i++)
+            solver->addClause(~objFunction[i]);
 
           posWeight++;
           currentWeight = orderWeights[posWeight];
           localCost = 0;
 
-          delete solver;
-          solver = rebuildBMO(functions, weights, currentWeight);
+          assumptions.clear();
+          addBMOFunction(currentWeight);
 
           if (verbosity > 0)
             printf("c LB : %-12" PRIu64 "\n", lbCost);
         } else {
 
           // Optimization of the current lexicographical function.
-          if (localCost == 0)
-            encoder.encodeCardinality(solver, objFunction,
-                                      newCost / currentWeight - 1);
-          else
-            encoder.updateCardinality(solver, newCost / currentWeight - 1);
+          // The constraint is encoded with an additional literal 'p' as
+          // 'objFunction + p <= cost'. Assuming 'p' excludes the current
+          // model, while without 'p' the constraint remains a valid bound on
+          // the current function once its optimum is known.
+          if (localCost == 0) {
+            Lit p = mkLit(solver->nVars(), false);
+            newSATVariable(solver);
+
+            vec<Lit> lits;
+            objFunction.copyTo(lits);
+            lits.push(p);
+            encoder.encodeCardinality(solver, lits, newCost / currentWeight);
+            assumptions.push(p);
+          } else
+            encoder.updateCardinality(solver, newCost / currentWeight);
 
           localCost = newCost;
         }
@@ -151,21 +172,19 @@ StatusCode LinearSU::bmoSearch() {
         }
       } else {
 
-        // The current lexicographical function has been optimize. Go to the
-        // next lexicographical function.
-        functions.push();
-        new (&functions[functions.size() - 1]) vec<Lit>();
-        objFunction.copyTo(functions[functions.size() - 1]);
-
-        weights.push(localCost / currentWeight);
+        // The current lexicographical function has been optimize. Its bound
+        // is made permanent and the search goes to the next lexicographical
+        // function.
+        if (assumptions.size() > 0)
+          solver->addClause(~assumptions[0]);
         lbCost += localCost;
 
         posWeight++;
         currentWeight = orderWeights[posWeight];
         localCost = 0;
 
-        delete solver;
-        solver = rebuildBMO(functions, weights, currentWeight);
+        assumptions.clear();
+        addBMOFunction(currentWeight);
 
         if (verbosity > 0)
           printf("c LB : %-12" PRIu64 "\n", lbCost);
@@ -197,17 +216,19 @@ StatusCode LinearSU::bmoSearch() {
 StatusCode LinearSU::normalSearch() {
 
   lbool res = l_True;
+  vec<Lit> dummy;
 
   initRelaxation();
   solver = rebuildSolver();
 
   while (res == l_True) {
 
-    vec<Lit> dummy;
     // Do not use preprocessing for linear search algorithm.
     // NOTE: When preprocessing is enabled the SAT solver simplifies the
     // relaxation variables which leads to incorrect results.
-    res = searchSATSolver(solver, dummy);
+    res = solveUntil(solver, deadline, dummy);
+    if (res == l_Undef)
+      return deadlineAnswer();
 
     if (res == l_True) {
       nbSatisfiable++;
@@ -236,16 +257,21 @@ StatusCode LinearSU::normalSearch() {
         }
 
       } else {
+        // A better model found by a concurrent solver tightens the bound.
+        ubCost = newCost;
+        if (sharedOptimum())
+          return _OPTIMUM_;
+        newCost = ubCost;
+
         if (maxsat_formula->getProblemType() == _WEIGHTED_) {
           if (!encoder.hasPBEncoding()){
-            // check if GTE encoding will generate too many clauses
-            // TODO: generalize this to all PB encodings
-            if (encoder.getPBEncoding() == _PB_GTE_){
+            // check if the PB encoding will generate too many clauses
+            if (encoder.getPBEncoding() != _PB_ADDER_){
               int expected_clauses = encoder.predictPB(solver, objFunction, coeffs, newCost-1);
-              if (expected_clauses >= _MAX_CLAUSES_) {
+              if (expected_clauses >= _MAX_CLAUSES_ || low_memory) {
                 printf("c Warn: changing to Adder encoding.\n");
                 encoder.setPBEncoding(_PB_ADDER_);
-              } else printf("c GTE auxiliary #clauses = %d\n",expected_clauses);
+              } else printf("c PB auxiliary #clauses = %d\n",expected_clauses);
             }
             encoder.encodePB(solver, objFunction, coeffs, newCost - 1);
           }
@@ -278,6 +304,237 @@ StatusCode LinearSU::normalSearch() {
   return _ERROR_;
 }
 
+/*_________________________________________________________________________________________________
+  |
+  |  anytimeSearch : [void] ->  [StatusCode]
+  |
+  |  Description:
+  |
+  |    Linear search with varying resolution of the weights. The weights are
+  |    first divided by a large power of 'ANYTIME_RESOLUTION' so that the
+  |    pseudo-Boolean constraint is small and good models are found quickly.
+  |    Each resolution gets an equal share of the remaining time, after which
+  |    the weights are refined, until the search is done with the original
+  |    weights. The phases are set to the best model found so far
+  |    (solution-phase saving). With the GTE encoding the bound of each
+  |    resolution is only enforced through assumptions (incremental GTE), so
+  |    the same solver and the encodings of its hard constraints are kept for
+  |    all resolutions. Otherwise, the bound is added as unit clauses and the
+  |    solver is rebuilt for the next resolution.
+  |
+  |  For further details see:
+  |    * Saurabh Joshi, Prateek Kumar, Sukrut Rao, Ruben Martins:
+  |      Open-WBO-Inc: Approximation Strategies for Incomplete Weighted
+  |      MaxSAT. JSAT 11(1): 73-97 (2019)
+  |
+  |  Pre-conditions:
+  |    * Assumes that 'deadline' has been set.
+  |
+  |  Post-conditions:
+  |    * 'ubCost' is updated.
+  |    * 'nbSatisfiable' is updated.
+  |    * 'nbCores' is updated.
+  |
+  |________________________________________________________________________________________________@*/
+StatusCode LinearSU::anytimeSearch() {
+  vec<Lit> dummy;
+  vec<uint64_t> dummyCoeffs;
+  initRelaxation();
+
+  uint64_t maxWeight = 0;
+  for (int i = 0; i < coeffs.size(); i++)
+    maxWeight = std::max(maxWeight, coeffs[i]);
+
+  uint64_t divisor = 1;
+  int levels = 1;
+  while (divisor <= maxWeight / ANYTIME_RESOLUTION) {
+    divisor *= ANYTIME_RESOLUTION;
+    levels++;
+  }
+
+  bool rebuild = true; // The solver has the unit clauses of a bound.
+  for (; levels > 0; levels--, divisor /= ANYTIME_RESOLUTION) {
+    bool last = divisor == 1;
+    double now = wallClockTime();
+    double until = last ? deadline : now + (deadline - now) / levels;
+
+    // Objective function with the weights at the current resolution.
+    vec<Lit> lits;
+    vec<uint64_t> weights;
+    vec<uint64_t> scaled;
+    for (int i = 0; i < objFunction.size(); i++) {
+      scaled.push(coeffs[i] / divisor);
+      if (scaled[i] > 0) {
+        lits.push(objFunction[i]);
+        weights.push(scaled[i]);
+      }
+    }
+
+    if (verbosity > 0)
+      printf("c Weight resolution: %" PRIu64 " (%d soft clauses)\n", divisor,
+             lits.size());
+
+    if (rebuild) {
+      if (solver != NULL)
+        delete solver;
+      solver = rebuildSolver();
+      rebuild = false;
+    }
+    if (model.size() != 0)
+      setPhase(solver);
+
+    // Bound on the objective function at the current resolution.
+    uint64_t bound = UINT64_MAX;
+    if (model.size() != 0) {
+      computeCostModel(model);
+      bound = 0;
+      for (int i = 0; i < costUnsat.size(); i++)
+        bound += scaled[costUnsat[i]];
+    }
+
+    // Only the GTE encoding is updated incrementally below, so it is also
+    // used by the automatic PB encoding (with the fallback to Adder).
+    Encoder enc(_INCREMENTAL_NONE_, encoding, _AMO_LADDER_,
+                pb_encoding == _PB_AUTO_ ? _PB_GTE_ : pb_encoding);
+    vec<Lit> assumptions;
+    for (;;) {
+      if (bound == 0)
+        break;
+
+      if (bound != UINT64_MAX) {
+        if (!enc.hasPBEncoding()) {
+          // Check if the PB encoding will generate too many clauses.
+          if (enc.getPBEncoding() != _PB_ADDER_ &&
+              (low_memory || enc.predictPB(solver, lits, weights,
+                                           bound - 1) >= _MAX_CLAUSES_)) {
+            if (verbosity > 0)
+              printf("c Warn: changing to Adder encoding.\n");
+            enc.setPBEncoding(_PB_ADDER_);
+          }
+          if (enc.getPBEncoding() == _PB_GTE_) {
+            enc.setIncremental(_INCREMENTAL_ITERATIVE_);
+            enc.incEncodePB(solver, lits, weights, bound - 1, assumptions,
+                            lits.size());
+          } else {
+            enc.encodePB(solver, lits, weights, bound - 1);
+            rebuild = true;
+          }
+        } else if (enc.getPBEncoding() == _PB_GTE_)
+          enc.incUpdatePB(solver, dummy, dummyCoeffs, bound - 1, assumptions);
+        else
+          enc.updatePB(solver, bound - 1);
+      }
+
+      lbool res = solveUntil(solver, until, assumptions);
+      if (res == l_Undef) {
+        if (wallClockTime() >= deadline)
+          return deadlineAnswer();
+        break;
+      }
+
+      if (res == l_False) {
+        nbCores++;
+        if (model.size() == 0) {
+          assert(bound == UINT64_MAX);
+          printAnswer(_UNSATISFIABLE_);
+          return _UNSATISFIABLE_;
+        }
+        if (last) {
+          printAnswer(_OPTIMUM_);
+          return _OPTIMUM_;
+        }
+        break;
+      }
+
+      nbSatisfiable++;
+      uint64_t newCost = computeCostModel(solver->model);
+      bound = 0;
+      for (int i = 0; i < costUnsat.size(); i++)
+        bound += scaled[costUnsat[i]];
+
+      if (newCost < ubCost || model.size() == 0) {
+        saveModel(solver->model);
+        printBound(newCost + off_set);
+        ubCost = newCost;
+      }
+
+      if (ubCost == 0 || exchangeBounds()) {
+        printAnswer(_OPTIMUM_);
+        return _OPTIMUM_;
+      }
+
+      // With the original weights only models better than 'ubCost' matter.
+      if (last)
+        bound = ubCost;
+    }
+  }
+
+  // Only reached if the search with the original weights was stopped early.
+  return deadlineAnswer();
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  solveUntil : (S : Solver *) (until : double) (assumptions : vec<Lit>&)
+  |               ->  [lbool]
+  |
+  |  Description:
+  |
+  |    Solves the formula under 'assumptions' in chunks of 'ANYTIME_CONFLICTS'
+  |    conflicts until it is solved or the wall-clock time 'until' is
+  |    reached, in which case l_Undef is returned. Without a deadline the
+  |    formula is solved at once.
+  |
+  |________________________________________________________________________________________________@*/
+lbool LinearSU::solveUntil(Solver *S, double until, vec<Lit> &assumptions) {
+  if (anytime_limit == 0)
+    return searchSATSolver(S, assumptions);
+
+  lbool res = l_Undef;
+  while (res == l_Undef && wallClockTime() < until)
+    res = searchSATSolver(S, assumptions, false, ANYTIME_CONFLICTS);
+  return res;
+}
+
+// Reports the best model found when the deadline is reached.
+StatusCode LinearSU::deadlineAnswer() {
+  if (verbosity > 0)
+    printf("c Deadline reached.\n");
+  printAnswer(_UNKNOWN_);
+  fflush(stdout);
+  return searchStatus;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  setPhase : (S : Solver *) ->  [void]
+  |
+  |  Description:
+  |
+  |    Sets the phases of the original and relaxation variables of 'S' to the
+  |    best model found so far.
+  |
+  |  Pre-conditions:
+  |    * Assumes that 'model' is not empty.
+  |
+  |________________________________________________________________________________________________@*/
+void LinearSU::setPhase(Solver *S) {
+  assert(model.size() != 0);
+
+  for (int i = 0; i < model.size(); i++)
+    S->setPolarity(i, model[i] == l_False);
+
+  // A literal of 'objFunction' is true when its soft clause is falsified. It
+  // may be negative when the soft clause is a unit used as its own label.
+  computeCostModel(model);
+  for (int i = 0; i < objFunction.size(); i++)
+    S->setPolarity(var(objFunction[i]), !sign(objFunction[i]));
+  for (int i = 0; i < costUnsat.size(); i++) {
+    Lit l = objFunction[costUnsat[i]];
+    S->setPolarity(var(l), sign(l));
+  }
+}
+
 // Public search method
 StatusCode LinearSU::search() {
 
@@ -286,9 +543,14 @@ StatusCode LinearSU::search() {
 
   printConfiguration(is_bmo, maxsat_formula->getProblemType());
 
+  if (anytime_limit > 0)
+    deadline = wallClockTime() + anytime_limit;
+
   if (maxsat_formula->getProblemType() == _WEIGHTED_) {
     if (bmoMode && is_bmo)
       return bmoSearch();
+    else if (anytime_limit > 0)
+      return anytimeSearch();
     else
       return normalSearch();
   } else
@@ -325,39 +587,33 @@ Solver *LinearSU::rebuildSolver(uint64_t min_weight) {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
+  vec<Lit> hard_clause;
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    maxsat_formula->getHardClause(i).clause.copyTo(hard_clause);
+    S->addClause(hard_clause);
+  }
 
   for (int i = 0; i < maxsat_formula->nPB(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     // Make sure the PB is on the form <=
     // if (maxsat_formula->getPBConstraint(i)->_sign)
     //  maxsat_formula->getPBConstraint(i)->changeSign();
     assert(maxsat_formula->getPBConstraint(i)->_sign);
 
-    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
-                  maxsat_formula->getPBConstraint(i)->_coeffs,
-                  maxsat_formula->getPBConstraint(i)->_rhs);
-
-    delete enc;
+    encoding_cache.encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
+                            maxsat_formula->getPBConstraint(i)->_coeffs,
+                            maxsat_formula->getPBConstraint(i)->_rhs);
   }
 
   for (int i = 0; i < maxsat_formula->nCard(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
-      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
+      encoding_cache.encodeAMO(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits);
     } else {
 
-      enc->encodeCardinality(S,
-                             maxsat_formula->getCardinalityConstraint(i)->_lits,
-                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
+      encoding_cache.encodeCardinality(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits,
+          maxsat_formula->getCardinalityConstraint(i)->_rhs);
     }
-
-    delete enc;
   }
 
   vec<Lit> clause;
@@ -381,37 +637,40 @@ Solver *LinearSU::rebuildSolver(uint64_t min_weight) {
 
 /*_________________________________________________________________________________________________
   |
-  |  rebuildBMO : (functions : int)  ->  [Solver *]
+  |  addBMOFunction : (currentWeight : uint64_t)  ->  [void]
   |
   |  Description:
   |
-  |    Rebuilds a SAT solver with the current MaxSAT formula.
-  |    Only considers soft clauses with the weight of the current
-  |    lexicographical optimization weight ('currentWeight')
-  |    For each function already computed in the BMO algorithm it encodes the
-  |    respective cardinality constraint.
+  |    Adds to 'solver' the soft clauses of the lexicographical function with
+  |    weight 'currentWeight' and makes it the objective function. The soft
+  |    clauses with larger weights must already be in 'solver'.
+  |
+  |  Post-conditions:
+  |    * 'objFunction' and 'coeffs' only contain the soft clauses with weight
+  |      'currentWeight'.
   |
   |________________________________________________________________________________________________@*/
-Solver *LinearSU::rebuildBMO(vec<vec<Lit>> &functions, vec<int> &rhs,
-                             uint64_t currentWeight) {
-
-  assert(functions.size() == rhs.size());
-
-  Solver *S = rebuildSolver(currentWeight);
+void LinearSU::addBMOFunction(uint64_t currentWeight) {
+  // The soft clauses of the first function are added by 'rebuildSolver'.
+  bool inSolver = currentWeight == orderWeights[0];
 
   objFunction.clear();
   coeffs.clear();
+  vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    if (maxsat_formula->getSoftClause(i).weight == currentWeight) {
-      objFunction.push(maxsat_formula->getSoftClause(i).relaxation_vars[0]);
-      coeffs.push(maxsat_formula->getSoftClause(i).weight);
-    }
-  }
+    if (maxsat_formula->getSoftClause(i).weight != currentWeight)
+      continue;
 
-  for (int i = 0; i < functions.size(); i++)
-    encoder.encodeCardinality(S, functions[i], rhs[i]);
+    objFunction.push(maxsat_formula->getSoftClause(i).relaxation_vars[0]);
+    coeffs.push(maxsat_formula->getSoftClause(i).weight);
 
-  return S;
+    if (!inSolver) {
+      clause.clear();
+      maxsat_formula->getSoftClause(i).clause.copyTo(clause);
+      clause.push(maxsat_formula->getSoftClause(i).relaxation_vars[0]);
+      solver->addClause(clause);
+    }
+  }
 }
 
 /************************************************************************************************
@@ -427,7 +686,8 @@ Solver *LinearSU::rebuildBMO(vec<vec<Lit>> &functions, vec<int> &rhs,
   |  Description:
   |
   |    Initializes the relaxation variables by adding a fresh variable to the
-  |    'relaxationVars' of each soft clause.
+  |    'relaxationVars' of each soft clause. Unit soft clauses are relaxed by
+  |    their label instead (see 'MaxSAT::getLabel').
   |
   |  Post-conditions:
   |    * 'objFunction' contains all relaxation variables that were added to soft
@@ -437,7 +697,7 @@ Solver *LinearSU::rebuildBMO(vec<vec<Lit>> &functions, vec<int> &rhs,
   |________________________________________________________________________________________________@*/
 void LinearSU::initRelaxation() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
+    Lit l = newRelaxationLiteral(i);
     maxsat_formula->getSoftClause(i).relaxation_vars.push(l);
     objFunction.push(l);
     coeffs.push(maxsat_formula->getSoftClause(i).weight);
@@ -50,8 +50,10 @@ class LinearSU : public MaxSAT {
 
 public:
   LinearSU(int verb = _VERBOSITY_MINIMAL_, bool bmo = true,
-           int enc = _CARD_MTOTALIZER_, int pb = _PB_SWC_)
+           int enc = _CARD_MTOTALIZER_, int pb = _PB_SWC_, int limit = 0)
       : solver(NULL), is_bmo(false) {
+    anytime_limit = limit;
+    deadline = 0;
     pb_encoding = pb;
     verbosity = verb;
     bmoMode = bmo;
@@ -91,15 +93,22 @@ public:
 protected:
   // Rebuild MaxSAT solver
   //
-  // Rebuild MaxSAT solver with BMO algorithm.
-  Solver *rebuildBMO(vec<vec<Lit>> &functions, vec<int> &weights,
-                     uint64_t currentWeight);
+  // Adds the soft clauses of a lexicographical function to the solver.
+  void addBMOFunction(uint64_t currentWeight);
   Solver *rebuildSolver(uint64_t min_weight = 1); // Rebuild MaxSAT solver.
 
   // Linear search algorithms.
   //
   StatusCode normalSearch(); // Classic linear search algorithm.
   StatusCode bmoSearch();    // Linear search algorithm with lexicographical order.
+  StatusCode anytimeSearch(); // Linear search with varying weight resolution.
+
+  // Anytime search
+  //
+  // Solves with a conflict budget until 'until' (wall-clock) is reached.
+  lbool solveUntil(Solver *S, double until, vec<Lit> &assumptions);
+  StatusCode deadlineAnswer(); // Reports the best model at the deadline.
+  void setPhase(Solver *S);    // Sets the phases to the best model.
 
   // Greater than comparator.
   bool static greaterThan(uint64_t i, uint64_t j) { return (i > j); }
@@ -127,6 +136,9 @@ protected:
                         // constraint that excludes models.
 
   bool is_bmo; // Stores if the formula is BMO or not.
+
+  int anytime_limit; // Wall-clock seconds of the anytime search (0=none).
+  double deadline;   // Wall-clock time at which the search stops.
 };
 } // namespace openwbo
 
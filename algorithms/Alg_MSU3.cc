@@ -81,28 +81,35 @@ StatusCode MSU3::MSU3_iterative() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++)
     coreMapping[getAssumptionLit(i)] = i;
 
+  // Soft clauses of the cores that were found but not relaxed yet.
+  vec<Lit> delayed;
+
   for (;;) {
 
     res = searchSATSolver(solver, assumptions);
     if (res == l_True) {
       nbSatisfiable++;
       uint64_t newCost = computeCostModel(solver->model);
-      saveModel(solver->model);
-      printBound(newCost);
-
-      ubCost = newCost;
+      if (newCost < ubCost || nbSatisfiable == 1) {
+        saveModel(solver->model);
+        printBound(newCost);
+        ubCost = newCost;
+      }
 
       if (nbSatisfiable == 1) {
         for (int i = 0; i < objFunction.size(); i++)
           assumptions.push(~objFunction[i]);
-      } else {
+        continue;
+      } else if (delayed.size() == 0) {
         assert(lbCost == newCost);
         printAnswer(_OPTIMUM_);
         return _OPTIMUM_;
       }
+      // Otherwise, the disjoint-core phase ends and the cores are relaxed.
     }
 
     if (res == l_False) {
+      processCore(solver);
       lbCost++;
       nbCores++;
       if (verbosity > 0)
@@ -113,6 +120,9 @@ StatusCode MSU3::MSU3_iterative() {
         return _UNSATISFIABLE_;
       }
 
+      if (sharedOptimum())
+        return _OPTIMUM_;
+
       if (lbCost == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
@@ -128,49 +138,95 @@ StatusCode MSU3::MSU3_iterative() {
         return _UNSATISFIABLE_;
       }
 
-      joinObjFunction.clear();
+      // A core without the cardinality constraint is disjoint from the
+      // relaxed soft clauses. In a disjoint-core phase its soft clauses are
+      // only removed from the assumptions and the search for cores goes on.
+      bool disjoint = disjoint_cores;
+      int nbDelayed = delayed.size();
       for (int i = 0; i < solver->conflict.size(); i++) {
-        if (coreMapping.find(solver->conflict[i]) != coreMapping.end()) {
-          assert(!activeSoft[coreMapping[solver->conflict[i]]]);
-          activeSoft[coreMapping[solver->conflict[i]]] = true;
-          joinObjFunction.push(
-              getRelaxationLit(coreMapping[solver->conflict[i]]));
-        }
-      }
-
-      currentObjFunction.clear();
-      assumptions.clear();
-      for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-        if (activeSoft[i])
-          currentObjFunction.push(getRelaxationLit(i));
+        if (coreMapping.has(solver->conflict[i]))
+          delayed.push(solver->conflict[i]);
         else
-          assumptions.push(~getAssumptionLit(i));
+          disjoint = false;
       }
 
-      if (verbosity > 0)
-        printf("c Relaxed soft clauses %d / %d\n", currentObjFunction.size(),
-               objFunction.size());
-
-      if (!encoder.hasCardEncoding()) {
-        if (lbCost != (unsigned)currentObjFunction.size()) {
-          encoder.buildCardinality(solver, currentObjFunction, lbCost);
-          encoder.incUpdateCardinality(solver, currentObjFunction, lbCost,
-                                       encodingAssumptions);
+      if (disjoint) {
+        int j = 0;
+        for (int i = nbDelayed; i < delayed.size(); i++)
+          activeSoft[coreMapping[delayed[i]]] = true;
+        for (int i = 0; i < assumptions.size(); i++)
+          if (!coreMapping.has(~assumptions[i]) ||
+              !activeSoft[coreMapping[~assumptions[i]]])
+            assumptions[j++] = assumptions[i];
+        assumptions.shrink(assumptions.size() - j);
+        for (int i = nbDelayed; i < delayed.size(); i++)
+          activeSoft[coreMapping[delayed[i]]] = false;
+
+        if (assumptions.size() > 0) {
+          nbDisjointCores++;
+          continue;
         }
-      } else {
-        // Incremental construction of the encoding.
-        if (joinObjFunction.size() > 0)
-          encoder.joinEncoding(solver, joinObjFunction, lbCost);
+      }
+    }
+
+    joinObjFunction.clear();
+    for (int i = 0; i < delayed.size(); i++) {
+      assert(!activeSoft[coreMapping[delayed[i]]]);
+      activeSoft[coreMapping[delayed[i]]] = true;
+      joinObjFunction.push(getRelaxationLit(coreMapping[delayed[i]]));
+    }
+    delayed.clear();
+
+    currentObjFunction.clear();
+    assumptions.clear();
+    for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+      if (activeSoft[i])
+        currentObjFunction.push(getRelaxationLit(i));
+      else
+        assumptions.push(~getAssumptionLit(i));
+    }
 
-        // The right-hand side is constrained using assumptions.
-        // NOTE: 'encodingAsssumptions' is modified in 'incrementalUpdate'.
+    if (verbosity > 0)
+      printf("c Relaxed soft clauses %d / %d\n", currentObjFunction.size(),
+             objFunction.size());
+
+    if (!encoder.hasCardEncoding()) {
+      if (lbCost != (unsigned)currentObjFunction.size()) {
+        encoder.buildCardinality(solver, currentObjFunction, lbCost);
         encoder.incUpdateCardinality(solver, currentObjFunction, lbCost,
                                      encodingAssumptions);
       }
+    } else {
+      // Incremental construction of the encoding.
+      if (joinObjFunction.size() > 0)
+        encoder.joinEncoding(solver, joinObjFunction, lbCost);
+
+      // The right-hand side is constrained using assumptions.
+      // NOTE: 'encodingAsssumptions' is modified in 'incrementalUpdate'.
+      encoder.incUpdateCardinality(solver, currentObjFunction, lbCost,
+                                   encodingAssumptions);
+    }
+
+    // Core exhaustion: increase the bound while the cardinality constraint
+    // alone is unsatisfiable.
+    while (core_exhaust_budget > 0 && encodingAssumptions.size() > 0 &&
+           lbCost + 1 < ubCost &&
+           lbCost + 1 < (unsigned)currentObjFunction.size()) {
+      res = searchSATSolver(solver, encodingAssumptions, false,
+                            core_exhaust_budget);
+      if (res != l_False)
+        break;
 
-      for (int i = 0; i < encodingAssumptions.size(); i++)
-        assumptions.push(encodingAssumptions[i]);
+      lbCost++;
+      nbExhaustedBounds++;
+      if (verbosity > 0)
+        printf("c LB : %-12" PRIu64 " (exhaustion)\n", lbCost);
+      encoder.incUpdateCardinality(solver, currentObjFunction, lbCost,
+                                   encodingAssumptions);
     }
+
+    for (int i = 0; i < encodingAssumptions.size(); i++)
+      assumptions.push(encodingAssumptions[i]);
   }
   return _ERROR_;
 }
@@ -228,8 +284,11 @@ Solver *MSU3::rebuildSolver() {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(getHardClause(i).clause);
+  vec<Lit> hard_clause;
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    getHardClause(i).clause.copyTo(hard_clause);
+    S->addClause(hard_clause);
+  }
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
@@ -244,36 +303,25 @@ Solver *MSU3::rebuildSolver() {
 
   // printf("c #PB: %d\n", maxsat_formula->nPB());
   for (int i = 0; i < maxsat_formula->nPB(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     // Make sure the PB is on the form <=
     if (!maxsat_formula->getPBConstraint(i)->_sign)
       maxsat_formula->getPBConstraint(i)->changeSign();
 
-    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
-                  maxsat_formula->getPBConstraint(i)->_coeffs,
-                  maxsat_formula->getPBConstraint(i)->_rhs);
-
-    // maxsat_formula->getPBConstraint(i)->print();
-
-    delete enc;
+    encoding_cache.encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
+                            maxsat_formula->getPBConstraint(i)->_coeffs,
+                            maxsat_formula->getPBConstraint(i)->_rhs);
   }
 
   // printf("c #Card: %d\n", maxsat_formula->nCard());
   for (int i = 0; i < maxsat_formula->nCard(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
-      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
+      encoding_cache.encodeAMO(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits);
     } else {
-      enc->encodeCardinality(S,
-                             maxsat_formula->getCardinalityConstraint(i)->_lits,
-                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
+      encoding_cache.encodeCardinality(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits,
+          maxsat_formula->getCardinalityConstraint(i)->_rhs);
     }
-
-    delete enc;
   }
 
   return S;
@@ -292,7 +340,8 @@ Solver *MSU3::rebuildSolver() {
   |  Description:
   |
   |    Initializes the relaxation variables by adding a fresh variable to the
-  |    'relaxationVars' of each soft clause.
+  |    'relaxationVars' of each soft clause. Unit soft clauses are relaxed by
+  |    their label instead (see 'MaxSAT::getLabel').
   |
   |  Post-conditions:
   |    * 'objFunction' contains all relaxation variables that were added to soft
@@ -301,7 +350,7 @@ Solver *MSU3::rebuildSolver() {
   |________________________________________________________________________________________________@*/
 void MSU3::initRelaxation() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
+    Lit l = newRelaxationLiteral(i);
     Soft &s = getSoftClause(i);
     s.relaxation_vars.push(l);
     s.assumption_var = l;
@@ -35,6 +35,7 @@
 #endif
 
 #include "../Encoder.h"
+#include "../LitMap.h"
 #include "../MaxSAT.h"
 #include <algorithm>
 #include <map>
@@ -103,8 +104,8 @@ protected:
   vec<int> coeffs; // Coefficients of the literals that are used in the
                    // constraint that excludes models.
 
-  std::map<Lit, int> coreMapping; // Mapping between the assumption literal and
-                                  // the respective soft clause.
+  LitMap<int> coreMapping; // Mapping between the assumption literal and
+                           // the respective soft clause.
 
   // Soft clauses that are currently in the MaxSAT formula.
   vec<bool> activeSoft;
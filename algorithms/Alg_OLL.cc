@@ -41,10 +41,10 @@ uint64_t OLL::findNextWeight(uint64_t weight,
 
   for (std::set<Lit>::iterator it = cardinality_assumptions.begin();
        it != cardinality_assumptions.end(); ++it) {
-    assert(boundMapping.find(*it) != boundMapping.end());
-    std::pair<std::pair<int, uint64_t>, uint64_t> soft_id = boundMapping[*it];
-    if (soft_id.second > nextWeight && soft_id.second < weight)
-      nextWeight = soft_id.second;
+    assert(boundMapping.has(*it));
+    CardinalityBound soft_id = boundMapping[*it];
+    if (soft_id.weight > nextWeight && soft_id.weight < weight)
+      nextWeight = soft_id.weight;
   }
 
   return nextWeight;
@@ -77,11 +77,11 @@ uint64_t OLL::findNextWeightDiversity(uint64_t weight,
 
     for (std::set<Lit>::iterator it = cardinality_assumptions.begin();
          it != cardinality_assumptions.end(); ++it) {
-      assert(boundMapping.find(*it) != boundMapping.end());
-      std::pair<std::pair<int, uint64_t>, uint64_t> soft_id = boundMapping[*it];
-      if (soft_id.second >= nextWeight) {
+      assert(boundMapping.has(*it));
+      CardinalityBound soft_id = boundMapping[*it];
+      if (soft_id.weight >= nextWeight) {
         nbClauses++;
-        nbWeights.insert(soft_id.second);
+        nbWeights.insert(soft_id.weight);
       }
     }
 
@@ -97,6 +97,232 @@ uint64_t OLL::findNextWeightDiversity(uint64_t weight,
   return nextWeight;
 }
 
+// Returns the weight of the soft clause or cardinality output 'p'.
+uint64_t OLL::assumptionWeight(Lit p) {
+  if (coreMapping.has(p))
+    return maxsat_formula->getSoftClause(coreMapping[p]).weight;
+
+  assert(boundMapping.has(p));
+  return boundMapping[p].weight;
+}
+
+// Removes from 'lits' the literals whose variable occurs in 'removed'.
+void OLL::removeLiterals(vec<Lit> &lits, vec<Lit> &removed) {
+  if (removed.size() == 0)
+    return;
+
+  varMark.growTo(solver->nVars(), false);
+  for (int i = 0; i < removed.size(); i++)
+    varMark[var(removed[i])] = true;
+
+  int j = 0;
+  for (int i = 0; i < lits.size(); i++)
+    if (!varMark[var(lits[i])])
+      lits[j++] = lits[i];
+  lits.shrink(lits.size() - j);
+
+  for (int i = 0; i < removed.size(); i++)
+    varMark[var(removed[i])] = false;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  harden : (assumptions : vec<Lit>&) (pending : vec<Lit>&)
+  |           (cardinality_assumptions : std::set<Lit>&) ->  [void]
+  |
+  |  Description:
+  |
+  |    Hardens the soft clauses and cardinality outputs whose weight is larger
+  |    than the gap between the upper and the lower bound. Relaxing any of
+  |    them would lead to a model with a cost larger than 'ubCost'.
+  |
+  |  For further details see:
+  |    * Alexey Ignatiev, Antonio Morgado, Joao Marques-Silva: RC2: an
+  |      Efficient MaxSAT Solver. JSAT 11(1): 53-64 (2019)
+  |
+  |  Post-conditions:
+  |    * The hardened literals are removed from 'assumptions', 'pending' and
+  |      'cardinality_assumptions'.
+  |    * 'nbHardened' is updated.
+  |
+  |________________________________________________________________________________________________@*/
+void OLL::harden(vec<Lit> &assumptions, vec<Lit> &pending,
+                 std::set<Lit> &cardinality_assumptions) {
+  if (nbSatisfiable == 0)
+    return;
+
+  assert(ubCost >= lbCost);
+  uint64_t gap = ubCost - lbCost;
+  if (gap >= maxsat_formula->getMaximumWeight())
+    return;
+
+  vec<Lit> hardened;
+  for (int i = 0; i < assumptions.size(); i++)
+    if (assumptionWeight(~assumptions[i]) > gap)
+      hardened.push(~assumptions[i]);
+  for (int i = 0; i < pending.size(); i++)
+    if (assumptionWeight(pending[i]) > gap)
+      hardened.push(pending[i]);
+
+  for (int i = 0; i < hardened.size(); i++) {
+    solver->addClause(~hardened[i]);
+    cardinality_assumptions.erase(hardened[i]);
+  }
+
+  removeLiterals(assumptions, hardened);
+  removeLiterals(pending, hardened);
+
+  nbHardened += hardened.size();
+  if (verbosity > 0 && hardened.size() > 0)
+    printf("c Hardened : %d (gap %" PRIu64 ")\n", hardened.size(), gap);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  exhaustCore : (soft_cardinality : vec<Encoder *>&) (id : int)
+  |                (bound : uint64_t&) (weight : uint64_t) ->  [Lit]
+  |
+  |  Description:
+  |
+  |    Core exhaustion. Increases the bound of the cardinality constraint 'id'
+  |    (over the literals of a core) while assuming that its output at the
+  |    current bound is false is unsatisfiable. Each of these SAT calls is
+  |    limited to 'core_exhaust_budget' conflicts.
+  |
+  |  Post-conditions:
+  |    * 'bound' is the new bound of the cardinality constraint.
+  |    * 'lbCost' is increased by 'weight' for each increment of the bound.
+  |    * Returns the output to be assumed, or 'lit_Undef' if the bound is
+  |      equal to the number of literals of the cardinality constraint.
+  |
+  |________________________________________________________________________________________________@*/
+Lit OLL::exhaustCore(vec<Encoder *> &soft_cardinality, int id,
+                     uint64_t &bound, uint64_t weight) {
+  Encoder *e = soft_cardinality[id];
+  assert(bound < (unsigned)e->outputs().size());
+  Lit out = e->outputs()[bound];
+
+  vec<Lit> assumps;
+  vec<Lit> joinObjFunction;
+  vec<Lit> encodingAssumptions;
+
+  while (core_exhaust_budget > 0 && lbCost + weight < ubCost) {
+    assumps.clear();
+    assumps.push(~out);
+    lbool res = searchSATSolver(solver, assumps, false, core_exhaust_budget);
+    if (res != l_False)
+      break;
+
+    lbCost += weight;
+    nbExhaustedBounds++;
+    if (verbosity > 0)
+      printf("c LB : %-12" PRIu64 " (exhaustion)\n", lbCost);
+
+    e->incUpdateCardinality(solver, joinObjFunction, e->lits(), bound + 1,
+                            encodingAssumptions);
+    bound++;
+    if (bound >= (unsigned)e->outputs().size())
+      return lit_Undef;
+    out = e->outputs()[bound];
+  }
+
+  return out;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  relaxCore : (core : vec<Lit>&) (cardinality_assumptions : std::set<Lit>&)
+  |              (soft_cardinality : vec<Encoder *>&) ->  [void]
+  |
+  |  Description:
+  |
+  |    Relaxes the core 'core' of the unweighted OLL algorithm. Soft clauses
+  |    in the core are relaxed, the bound of the cardinality constraints
+  |    whose output is in the core is increased, and a new cardinality
+  |    constraint is built over the relaxed literals.
+  |
+  |________________________________________________________________________________________________@*/
+void OLL::relaxCore(vec<Lit> &core, std::set<Lit> &cardinality_assumptions,
+                    vec<Encoder *> &soft_cardinality) {
+  vec<Lit> joinObjFunction;
+  vec<Lit> encodingAssumptions;
+  vec<Lit> soft_relax;
+  vec<Lit> cardinality_relax;
+
+  for (int i = 0; i < core.size(); i++) {
+    Lit p = core[i];
+    if (coreMapping.has(p)) {
+      assert(!activeSoft[coreMapping[p]]);
+      activeSoft[coreMapping[p]] = true;
+      assert(p == maxsat_formula->getSoftClause(coreMapping[p])
+                      .relaxation_vars[0]);
+      soft_relax.push(p);
+    }
+
+    if (boundMapping.has(p)) {
+      std::set<Lit>::iterator it;
+      it = cardinality_assumptions.find(p);
+      assert(it != cardinality_assumptions.end());
+      cardinality_assumptions.erase(it);
+      cardinality_relax.push(p);
+
+      // this is a soft cardinality -- bound must be increased
+      CardinalityBound soft_id = boundMapping[p];
+      // increase the bound
+      assert(soft_id.id < soft_cardinality.size());
+      assert(soft_cardinality[soft_id.id]->hasCardEncoding());
+
+      joinObjFunction.clear();
+      encodingAssumptions.clear();
+      soft_cardinality[soft_id.id]->incUpdateCardinality(
+          solver, joinObjFunction, soft_cardinality[soft_id.id]->lits(),
+          soft_id.bound + 1, encodingAssumptions);
+
+      // if the bound is the same as the number of lits then no restriction
+      // is applied
+      if (soft_id.bound + 1 <
+          (unsigned)soft_cardinality[soft_id.id]->outputs().size()) {
+        assert((unsigned)soft_cardinality[soft_id.id]->outputs().size() >
+               soft_id.bound + 1);
+        Lit out = soft_cardinality[soft_id.id]->outputs()[soft_id.bound + 1];
+        boundMapping[out] = CardinalityBound(soft_id.id, soft_id.bound + 1, 1);
+        cardinality_assumptions.insert(out);
+      }
+    }
+  }
+
+  assert(soft_relax.size() + cardinality_relax.size() > 0);
+
+  if (soft_relax.size() == 1 && cardinality_relax.size() == 0) {
+    // Unit core
+    solver->addClause(soft_relax[0]);
+  }
+
+  if (soft_relax.size() + cardinality_relax.size() > 1) {
+
+    vec<Lit> relax_harden;
+    soft_relax.copyTo(relax_harden);
+    for (int i = 0; i < cardinality_relax.size(); i++)
+      relax_harden.push(cardinality_relax[i]);
+
+    Encoder *e = new Encoder();
+    e->setIncremental(_INCREMENTAL_ITERATIVE_);
+    e->setLazy(true);
+    e->buildCardinality(solver, relax_harden, 1);
+    soft_cardinality.push(e);
+    assert(e->outputs().size() > 1);
+
+    uint64_t bound = 1;
+    Lit out = exhaustCore(soft_cardinality, soft_cardinality.size() - 1, bound,
+                          1);
+    if (out != lit_Undef) {
+      boundMapping[out] =
+          CardinalityBound(soft_cardinality.size() - 1, bound, 1);
+      cardinality_assumptions.insert(out);
+    }
+  }
+}
+
 StatusCode OLL::unweighted() {
   // printf("unweighted\n");
 
@@ -106,9 +332,6 @@ StatusCode OLL::unweighted() {
   solver = rebuildSolver();
 
   vec<Lit> assumptions;
-  vec<Lit> joinObjFunction;
-  vec<Lit> currentObjFunction;
-  vec<Lit> encodingAssumptions;
   encoder.setIncremental(_INCREMENTAL_ITERATIVE_);
 
   activeSoft.growTo(maxsat_formula->nSoft(), false);
@@ -118,22 +341,27 @@ StatusCode OLL::unweighted() {
   std::set<Lit> cardinality_assumptions;
   vec<Encoder *> soft_cardinality;
 
+  // Cores that were found but not relaxed yet.
+  vec<vec<Lit> > delayed;
+
   for (;;) {
 
     res = searchSATSolver(solver, assumptions);
     if (res == l_True) {
       nbSatisfiable++;
       uint64_t newCost = computeCostModel(solver->model);
-      saveModel(solver->model);
-      if (maxsat_formula->getFormat() == _FORMAT_PB_) {
-        // optimization problem
-        if (maxsat_formula->getObjFunction() != NULL) {
+      if (newCost < ubCost || nbSatisfiable == 1) {
+        saveModel(solver->model);
+        if (maxsat_formula->getFormat() == _FORMAT_PB_) {
+          // optimization problem
+          if (maxsat_formula->getObjFunction() != NULL) {
+            printBound(newCost + off_set);
+          }
+        } else
           printBound(newCost + off_set);
-        }
-      } else
-        printBound(newCost + off_set);
 
-      ubCost = newCost;
+        ubCost = newCost;
+      }
 
       if (nbSatisfiable == 1) {
         if (newCost == 0) {
@@ -149,14 +377,17 @@ StatusCode OLL::unweighted() {
 
         for (int i = 0; i < maxsat_formula->nSoft(); i++)
           assumptions.push(~maxsat_formula->getSoftClause(i).assumption_var);
-      } else {
+        continue;
+      } else if (delayed.size() == 0) {
         assert(lbCost == newCost);
         printAnswer(_OPTIMUM_);
         return _OPTIMUM_;
       }
+      // Otherwise, the disjoint-core phase ends and the cores are relaxed.
     }
 
     if (res == l_False) {
+      processCore(solver);
       lbCost++;
       nbCores++;
       if (verbosity > 0)
@@ -167,6 +398,9 @@ StatusCode OLL::unweighted() {
         return _UNSATISFIABLE_;
       }
 
+      if (sharedOptimum())
+        return _OPTIMUM_;
+
       if (lbCost == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
@@ -177,119 +411,42 @@ StatusCode OLL::unweighted() {
 
       sumSizeCores += solver->conflict.size();
 
-      vec<Lit> soft_relax;
-      vec<Lit> cardinality_relax;
-
-      for (int i = 0; i < solver->conflict.size(); i++) {
-        Lit p = solver->conflict[i];
-        if (coreMapping.find(p) != coreMapping.end()) {
-          assert(!activeSoft[coreMapping[p]]);
-          activeSoft[coreMapping[solver->conflict[i]]] = true;
-          assert(p ==
-                 maxsat_formula->getSoftClause(coreMapping[solver->conflict[i]])
-                     .relaxation_vars[0]);
-          soft_relax.push(p);
-        }
-
-        if (boundMapping.find(p) != boundMapping.end()) {
-          std::set<Lit>::iterator it;
-          it = cardinality_assumptions.find(p);
-          assert(it != cardinality_assumptions.end());
-          cardinality_assumptions.erase(it);
-          cardinality_relax.push(p);
+      delayed.push();
+      solver->conflict.copyTo(delayed.last());
 
-          // this is a soft cardinality -- bound must be increased
-          std::pair<std::pair<int, int>, int> soft_id =
-              boundMapping[solver->conflict[i]];
-          // increase the bound
-          assert(soft_id.first.first < soft_cardinality.size());
-          assert(soft_cardinality[soft_id.first.first]->hasCardEncoding());
-
-          joinObjFunction.clear();
-          encodingAssumptions.clear();
-          soft_cardinality[soft_id.first.first]->incUpdateCardinality(
-              solver, joinObjFunction,
-              soft_cardinality[soft_id.first.first]->lits(),
-              soft_id.first.second + 1, encodingAssumptions);
-
-          // if the bound is the same as the number of lits then no restriction
-          // is applied
-          if (soft_id.first.second + 1 <
-              soft_cardinality[soft_id.first.first]->outputs().size()) {
-            assert(soft_cardinality[soft_id.first.first]->outputs().size() >
-                   soft_id.first.second + 1);
-            Lit out = soft_cardinality[soft_id.first.first]
-                          ->outputs()[soft_id.first.second + 1];
-            boundMapping[out] = std::make_pair(
-                std::make_pair(soft_id.first.first, soft_id.first.second + 1),
-                1);
-            cardinality_assumptions.insert(out);
-          }
+      if (disjoint_cores) {
+        // Disjoint-core phase: the literals of the core are only removed from
+        // the assumptions and the search for cores goes on.
+        removeLiterals(assumptions, solver->conflict);
+        if (assumptions.size() > 0) {
+          nbDisjointCores++;
+          continue;
         }
       }
+    }
 
-      assert(soft_relax.size() + cardinality_relax.size() > 0);
-
-      if (soft_relax.size() == 1 && cardinality_relax.size() == 0) {
-        // Unit core
-        solver->addClause(soft_relax[0]);
-      }
-
-      // assert (soft_relax.size() > 0 || cardinality_relax.size() != 1);
-
-      if (soft_relax.size() + cardinality_relax.size() > 1) {
-
-        vec<Lit> relax_harden;
-        soft_relax.copyTo(relax_harden);
-        for (int i = 0; i < cardinality_relax.size(); i++)
-          relax_harden.push(cardinality_relax[i]);
-
-        /*
-                for (int i = 0; i < nSoft(); i++){
-                  printf("soft %d, w: %d, r:
-           %d\n",i,softClauses[i].weight,var(softClauses[i].relaxationVars[0])+1);
-                  for (int j = 0; j < softClauses[i].clause.size(); j++){
-                    printf("%d ",var(softClauses[i].clause[j])+1);
-                  }
-                  printf("\n");
-                }
-
-                for (int i = 0; i < relax_harden.size(); i++)
-                  printf("+1 x%d ",var(relax_harden[i])+1);
-                printf(" <= 1\n");
-        */
-
-        Encoder *e = new Encoder();
-        e->setIncremental(_INCREMENTAL_ITERATIVE_);
-        e->buildCardinality(solver, relax_harden, 1);
-        soft_cardinality.push(e);
-        assert(e->outputs().size() > 1);
-
-        Lit out = e->outputs()[1];
-        boundMapping[out] =
-            std::make_pair(std::make_pair(soft_cardinality.size() - 1, 1), 1);
-        cardinality_assumptions.insert(out);
-      }
+    for (int i = 0; i < delayed.size(); i++)
+      relaxCore(delayed[i], cardinality_assumptions, soft_cardinality);
+    delayed.clear();
 
-      // reset the assumptions
-      assumptions.clear();
-      int active_soft = 0;
-      for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-        if (!activeSoft[i])
-          assumptions.push(~maxsat_formula->getSoftClause(i).assumption_var);
-        else
-          active_soft++;
-      }
+    // reset the assumptions
+    assumptions.clear();
+    int active_soft = 0;
+    for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+      if (!activeSoft[i])
+        assumptions.push(~maxsat_formula->getSoftClause(i).assumption_var);
+      else
+        active_soft++;
+    }
 
-      for (std::set<Lit>::iterator it = cardinality_assumptions.begin();
-           it != cardinality_assumptions.end(); ++it) {
-        assumptions.push(~(*it));
-      }
+    for (std::set<Lit>::iterator it = cardinality_assumptions.begin();
+         it != cardinality_assumptions.end(); ++it) {
+      assumptions.push(~(*it));
+    }
 
-      if (verbosity > 0) {
-        printf("c Relaxed soft clauses %d / %d\n", active_soft,
-               maxsat_formula->nSoft());
-      }
+    if (verbosity > 0) {
+      printf("c Relaxed soft clauses %d / %d\n", active_soft,
+             maxsat_formula->nSoft());
     }
   }
 }
@@ -313,6 +470,10 @@ StatusCode OLL::weighted() {
   std::set<Lit> cardinality_assumptions;
   vec<Encoder *> soft_cardinality;
 
+  // Soft clauses and cardinality outputs that are not assumed because their
+  // weight is below 'min_weight'.
+  vec<Lit> pending;
+
   min_weight = maxsat_formula->getMaximumWeight();
   // printf("current weight %d\n",maxsat_formula->getMaximumWeight());
 
@@ -342,71 +503,41 @@ StatusCode OLL::weighted() {
         for (int i = 0; i < maxsat_formula->nSoft(); i++)
           if (maxsat_formula->getSoftClause(i).weight >= min_weight)
             assumptions.push(~maxsat_formula->getSoftClause(i).assumption_var);
-      } else {
-        // compute min weight in soft
-        int not_considered = 0;
-        for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-          if (maxsat_formula->getSoftClause(i).weight < min_weight)
-            not_considered++;
-        }
+          else
+            pending.push(maxsat_formula->getSoftClause(i).assumption_var);
+      } else if (pending.size() != 0) {
+        min_weight =
+            findNextWeightDiversity(min_weight, cardinality_assumptions);
 
-        // printf("not considered %d\n",not_considered);
+        // printf("currentWeight %d\n",currentWeight);
 
-        for (std::set<Lit>::iterator it = cardinality_assumptions.begin();
-             it != cardinality_assumptions.end(); ++it) {
-          assert(boundMapping.find(*it) != boundMapping.end());
-          std::pair<std::pair<int, uint64_t>, uint64_t> soft_id =
-              boundMapping[*it];
-          if (soft_id.second < min_weight)
-            not_considered++;
+        // Assume the pending literals that reached the new weight.
+        int j = 0;
+        for (int i = 0; i < pending.size(); i++) {
+          if (assumptionWeight(pending[i]) >= min_weight)
+            assumptions.push(~pending[i]);
+          else
+            pending[j++] = pending[i];
         }
+        pending.shrink(pending.size() - j);
 
-        if (not_considered != 0) {
-          min_weight =
-              findNextWeightDiversity(min_weight, cardinality_assumptions);
-
-          // printf("currentWeight %d\n",currentWeight);
-
-          // reset the assumptions
-          assumptions.clear();
-          int active_soft = 0;
-          for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-            if (!activeSoft[i] &&
-                maxsat_formula->getSoftClause(i).weight >= min_weight) {
-              assumptions.push(
-                  ~maxsat_formula->getSoftClause(i).assumption_var);
-              // printf("s assumption
-              // %d\n",var(softClauses[i].assumptionVar)+1);
-            } else
-              active_soft++;
-          }
-
-          // printf("assumptions %d\n",assumptions.size());
-          for (std::set<Lit>::iterator it = cardinality_assumptions.begin();
-               it != cardinality_assumptions.end(); ++it) {
-            assert(boundMapping.find(*it) != boundMapping.end());
-            std::pair<std::pair<int, uint64_t>, uint64_t> soft_id =
-                boundMapping[*it];
-            if (soft_id.second >= min_weight)
-              assumptions.push(~(*it));
-            // printf("c assumption %d\n",var(*it)+1);
-          }
-
-        } else {
-          assert(lbCost == newCost);
-          printAnswer(_OPTIMUM_);
-          return _OPTIMUM_;
-        }
+      } else {
+        assert(lbCost == newCost);
+        printAnswer(_OPTIMUM_);
+        return _OPTIMUM_;
       }
+
+      harden(assumptions, pending, cardinality_assumptions);
     }
 
     if (res == l_False) {
+      processCore(solver);
 
       // reduce the weighted to the unweighted case
       uint64_t min_core = UINT64_MAX;
       for (int i = 0; i < solver->conflict.size(); i++) {
         Lit p = solver->conflict[i];
-        if (coreMapping.find(p) != coreMapping.end()) {
+        if (coreMapping.has(p)) {
           assert(!activeSoft[coreMapping[p]]);
           if (maxsat_formula->getSoftClause(coreMapping[solver->conflict[i]])
                   .weight < min_core)
@@ -415,11 +546,10 @@ StatusCode OLL::weighted() {
                     .weight;
         }
 
-        if (boundMapping.find(p) != boundMapping.end()) {
-          std::pair<std::pair<int, uint64_t>, uint64_t> soft_id =
-              boundMapping[solver->conflict[i]];
-          if (soft_id.second < min_core)
-            min_core = soft_id.second;
+        if (boundMapping.has(p)) {
+          CardinalityBound soft_id = boundMapping[solver->conflict[i]];
+          if (soft_id.weight < min_core)
+            min_core = soft_id.weight;
         }
       }
 
@@ -435,6 +565,9 @@ StatusCode OLL::weighted() {
         return _UNSATISFIABLE_;
       }
 
+      if (sharedOptimum())
+        return _OPTIMUM_;
+
       if (lbCost == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
@@ -447,10 +580,12 @@ StatusCode OLL::weighted() {
 
       vec<Lit> soft_relax;
       vec<Lit> cardinality_relax;
+      vec<Lit> relaxed; // Literals of the core that are no longer assumed.
+      vec<Lit> new_assumptions; // New cardinality outputs to be assumed.
 
       for (int i = 0; i < solver->conflict.size(); i++) {
         Lit p = solver->conflict[i];
-        if (coreMapping.find(p) != coreMapping.end()) {
+        if (coreMapping.has(p)) {
           if (maxsat_formula->getSoftClause(coreMapping[p]).weight > min_core) {
             // printf("SPLIT THE CLAUSE\n");
             assert(!activeSoft[coreMapping[p]]);
@@ -461,6 +596,10 @@ StatusCode OLL::weighted() {
 
             // Update the weight of the soft clause.
             maxsat_formula->getSoftClause(indexSoft).weight -= min_core;
+            if (maxsat_formula->getSoftClause(indexSoft).weight < min_weight) {
+              relaxed.push(p);
+              pending.push(p);
+            }
 
             vec<Lit> clause;
             vec<Lit> vars;
@@ -516,10 +655,11 @@ StatusCode OLL::weighted() {
             // printf("ASSERT %d\n",var(p)+1);
             assert(!activeSoft[coreMapping[p]]);
             activeSoft[coreMapping[p]] = true;
+            relaxed.push(p);
           }
         }
 
-        if (boundMapping.find(p) != boundMapping.end()) {
+        if (boundMapping.has(p)) {
           // printf("CARD IN CORE\n");
 
           std::set<Lit>::iterator it;
@@ -527,39 +667,38 @@ StatusCode OLL::weighted() {
           assert(it != cardinality_assumptions.end());
 
           // this is a soft cardinality -- bound must be increased
-          std::pair<std::pair<int, uint64_t>, uint64_t> soft_id =
-              boundMapping[solver->conflict[i]];
+          CardinalityBound soft_id = boundMapping[solver->conflict[i]];
           // increase the bound
-          assert(soft_id.first.first < soft_cardinality.size());
-          assert(soft_cardinality[soft_id.first.first]->hasCardEncoding());
+          assert(soft_id.id < soft_cardinality.size());
+          assert(soft_cardinality[soft_id.id]->hasCardEncoding());
 
-          if (soft_id.second == min_core) {
+          if (soft_id.weight == min_core) {
 
             cardinality_assumptions.erase(it);
             cardinality_relax.push(p);
+            relaxed.push(p);
 
             joinObjFunction.clear();
             encodingAssumptions.clear();
-            soft_cardinality[soft_id.first.first]->incUpdateCardinality(
-                solver, joinObjFunction,
-                soft_cardinality[soft_id.first.first]->lits(),
-                soft_id.first.second + 1, encodingAssumptions);
+            soft_cardinality[soft_id.id]->incUpdateCardinality(
+                solver, joinObjFunction, soft_cardinality[soft_id.id]->lits(),
+                soft_id.bound + 1, encodingAssumptions);
 
             // if the bound is the same as the number of lits then no
             // restriction is applied
-            if (soft_id.first.second + 1 <
-                (unsigned)soft_cardinality[soft_id.first.first]
+            if (soft_id.bound + 1 <
+                (unsigned)soft_cardinality[soft_id.id]
                     ->outputs()
                     .size()) {
-              assert((unsigned)soft_cardinality[soft_id.first.first]
+              assert((unsigned)soft_cardinality[soft_id.id]
                          ->outputs()
-                         .size() > soft_id.first.second + 1);
-              Lit out = soft_cardinality[soft_id.first.first]
-                            ->outputs()[soft_id.first.second + 1];
-              boundMapping[out] = std::make_pair(
-                  std::make_pair(soft_id.first.first, soft_id.first.second + 1),
-                  min_core);
+                         .size() > soft_id.bound + 1);
+              Lit out = soft_cardinality[soft_id.id]
+                            ->outputs()[soft_id.bound + 1];
+              boundMapping[out] =
+                  CardinalityBound(soft_id.id, soft_id.bound + 1, min_core);
               cardinality_assumptions.insert(out);
+              new_assumptions.push(out);
             }
 
           } else {
@@ -568,52 +707,54 @@ StatusCode OLL::weighted() {
             // duplicate cardinality constraint???
             Encoder *e = new Encoder();
             e->setIncremental(_INCREMENTAL_ITERATIVE_);
+            e->setLazy(true);
             e->buildCardinality(solver,
-                                soft_cardinality[soft_id.first.first]->lits(),
-                                soft_id.first.second);
+                                soft_cardinality[soft_id.id]->lits(),
+                                soft_id.bound);
 
-            assert((unsigned)e->outputs().size() > soft_id.first.second);
-            Lit out = e->outputs()[soft_id.first.second];
+            assert((unsigned)e->outputs().size() > soft_id.bound);
+            Lit out = e->outputs()[soft_id.bound];
             soft_cardinality.push(e);
 
             boundMapping[out] =
-                std::make_pair(std::make_pair(soft_cardinality.size() - 1,
-                                              soft_id.first.second),
-                               min_core);
+                CardinalityBound(soft_cardinality.size() - 1, soft_id.bound,
+                                 min_core);
             cardinality_relax.push(out);
 
             // Update value of the previous cardinality constraint
-            assert(soft_id.second - min_core > 0);
-            boundMapping[p] = std::make_pair(
-                std::make_pair(soft_id.first.first, soft_id.first.second),
-                soft_id.second - min_core);
+            assert(soft_id.weight - min_core > 0);
+            boundMapping[p] = CardinalityBound(soft_id.id, soft_id.bound,
+                                               soft_id.weight - min_core);
+            if (soft_id.weight - min_core < min_weight) {
+              relaxed.push(p);
+              pending.push(p);
+            }
 
             // Update bound as usual...
 
-            std::pair<std::pair<int, int>, int> soft_core_id =
-                boundMapping[out];
+            CardinalityBound soft_core_id = boundMapping[out];
 
             joinObjFunction.clear();
             encodingAssumptions.clear();
-            soft_cardinality[soft_core_id.first.first]->incUpdateCardinality(
+            soft_cardinality[soft_core_id.id]->incUpdateCardinality(
                 solver, joinObjFunction,
-                soft_cardinality[soft_core_id.first.first]->lits(),
-                soft_core_id.first.second + 1, encodingAssumptions);
+                soft_cardinality[soft_core_id.id]->lits(),
+                soft_core_id.bound + 1, encodingAssumptions);
 
             // if the bound is the same as the number of lits then no
             // restriction is applied
-            if (soft_core_id.first.second + 1 <
-                soft_cardinality[soft_core_id.first.first]->outputs().size()) {
-              assert(
-                  soft_cardinality[soft_core_id.first.first]->outputs().size() >
-                  soft_core_id.first.second + 1);
-              Lit out = soft_cardinality[soft_core_id.first.first]
-                            ->outputs()[soft_core_id.first.second + 1];
+            if (soft_core_id.bound + 1 <
+                (unsigned)soft_cardinality[soft_core_id.id]->outputs().size()) {
+              assert((unsigned)soft_cardinality[soft_core_id.id]
+                         ->outputs()
+                         .size() > soft_core_id.bound + 1);
+              Lit out = soft_cardinality[soft_core_id.id]
+                            ->outputs()[soft_core_id.bound + 1];
               boundMapping[out] =
-                  std::make_pair(std::make_pair(soft_core_id.first.first,
-                                                soft_core_id.first.second + 1),
-                                 min_core);
+                  CardinalityBound(soft_core_id.id, soft_core_id.bound + 1,
+                                   min_core);
               cardinality_assumptions.insert(out);
+              new_assumptions.push(out);
             }
 #else
 
@@ -636,43 +777,40 @@ StatusCode OLL::weighted() {
             clause.push(p);
             solver->addClause(clause);
 
-            boundMapping[l] = std::make_pair(
-                std::make_pair(soft_id.first.first, soft_id.first.second),
-                min_core);
+            boundMapping[l] =
+                CardinalityBound(soft_id.id, soft_id.bound, min_core);
             cardinality_relax.push(l);
 
             // Update bound as usual...
 
-            std::pair<std::pair<int, int>, int> soft_core_id = boundMapping[p];
+            CardinalityBound soft_core_id = boundMapping[p];
 
             joinObjFunction.clear();
             encodingAssumptions.clear();
-            soft_cardinality[soft_core_id.first.first]->incUpdateCardinality(
+            soft_cardinality[soft_core_id.id]->incUpdateCardinality(
                 solver, joinObjFunction,
-                soft_cardinality[soft_core_id.first.first]->lits(),
-                soft_core_id.first.second + 1, encodingAssumptions);
+                soft_cardinality[soft_core_id.id]->lits(),
+                soft_core_id.bound + 1, encodingAssumptions);
 
             // if the bound is the same as the number of lits then no
             // restriction is applied
-            if (soft_core_id.first.second + 1 <
-                soft_cardinality[soft_core_id.first.first]->outputs().size()) {
+            if (soft_core_id.bound + 1 <
+                soft_cardinality[soft_core_id.id]->outputs().size()) {
               assert(
-                  soft_cardinality[soft_core_id.first.first]->outputs().size() >
-                  soft_core_id.first.second + 1);
-              Lit out = soft_cardinality[soft_core_id.first.first]
-                            ->outputs()[soft_core_id.first.second + 1];
+                  soft_cardinality[soft_core_id.id]->outputs().size() >
+                  soft_core_id.bound + 1);
+              Lit out = soft_cardinality[soft_core_id.id]
+                            ->outputs()[soft_core_id.bound + 1];
               boundMapping[out] =
-                  std::make_pair(std::make_pair(soft_core_id.first.first,
-                                                soft_core_id.first.second + 1),
-                                 min_core);
+                  CardinalityBound(soft_core_id.id, soft_core_id.bound + 1,
+                                   min_core);
               cardinality_assumptions.insert(out);
             }
 
             // Update value of the previous cardinality constraint
-            assert(soft_id.second - min_core > 0);
-            boundMapping[p] = std::make_pair(
-                std::make_pair(soft_id.first.first, soft_id.first.second),
-                soft_id.second - min_core);
+            assert(soft_id.weight - min_core > 0);
+            boundMapping[p] = CardinalityBound(soft_id.id, soft_id.bound,
+                                               soft_id.weight - min_core);
 
 #endif
           }
@@ -712,43 +850,35 @@ StatusCode OLL::weighted() {
         */
         Encoder *e = new Encoder();
         e->setIncremental(_INCREMENTAL_ITERATIVE_);
+        e->setLazy(true);
         e->buildCardinality(solver, relax_harden, 1);
         soft_cardinality.push(e);
         assert(e->outputs().size() > 1);
 
         // printf("outputs %d\n",e->outputs().size());
-        Lit out = e->outputs()[1];
-        boundMapping[out] = std::make_pair(
-            std::make_pair(soft_cardinality.size() - 1, 1), min_core);
-        cardinality_assumptions.insert(out);
-      }
-
-      // reset the assumptions
-      assumptions.clear();
-      int active_soft = 0;
-      for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-        if (!activeSoft[i] &&
-            maxsat_formula->getSoftClause(i).weight >= min_weight) {
-          assumptions.push(~maxsat_formula->getSoftClause(i).assumption_var);
-          // printf("s assumption %d\n",var(softClauses[i].assumptionVar)+1);
-        } else
-          active_soft++;
+        uint64_t bound = 1;
+        Lit out = exhaustCore(soft_cardinality, soft_cardinality.size() - 1,
+                              bound, min_core);
+        if (out != lit_Undef) {
+          boundMapping[out] = CardinalityBound(soft_cardinality.size() - 1,
+                                               bound, min_core);
+          cardinality_assumptions.insert(out);
+          new_assumptions.push(out);
+        }
       }
 
-      // printf("assumptions %d\n",assumptions.size());
-      for (std::set<Lit>::iterator it = cardinality_assumptions.begin();
-           it != cardinality_assumptions.end(); ++it) {
-        assert(boundMapping.find(*it) != boundMapping.end());
-        std::pair<std::pair<int, uint64_t>, uint64_t> soft_id =
-            boundMapping[*it];
-        if (soft_id.second >= min_weight)
-          assumptions.push(~(*it));
-        // printf("c assumption %d\n",var(*it)+1);
-      }
+      // Update the assumptions with the literals that changed in this core.
+      removeLiterals(assumptions, relaxed);
+      for (int i = 0; i < new_assumptions.size(); i++)
+        assumptions.push(~new_assumptions[i]);
 
-      // printf("card assumptions %d\n",assumptions.size());
+      harden(assumptions, pending, cardinality_assumptions);
 
       if (verbosity > 0) {
+        int active_soft = 0;
+        for (int i = 0; i < activeSoft.size(); i++)
+          if (activeSoft[i])
+            active_soft++;
         printf("c Relaxed soft clauses %d / %d\n", active_soft,
                maxsat_formula->nSoft());
       }
@@ -758,7 +888,7 @@ StatusCode OLL::weighted() {
 
 StatusCode OLL::search() {
 
-  if (encoding != _CARD_TOTALIZER_) {
+  if (encoding != _CARD_TOTALIZER_ && encoding != _CARD_AUTO_) {
     if(print) {
       printf("Error: Currently algorithm MSU3 with iterative encoding only "
              "supports the totalizer encoding.\n");
@@ -801,41 +931,33 @@ Solver *OLL::rebuildSolver() {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
+  vec<Lit> hard_clause;
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    maxsat_formula->getHardClause(i).clause.copyTo(hard_clause);
+    S->addClause(hard_clause);
+  }
 
   // printf("c #PB: %d\n", maxsat_formula->nPB());
   for (int i = 0; i < maxsat_formula->nPB(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     // Make sure the PB is on the form <=
     if (!maxsat_formula->getPBConstraint(i)->_sign)
       maxsat_formula->getPBConstraint(i)->changeSign();
 
-    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
-                  maxsat_formula->getPBConstraint(i)->_coeffs,
-                  maxsat_formula->getPBConstraint(i)->_rhs);
-
-    // maxsat_formula->getPBConstraint(i)->print();
-
-    delete enc;
+    encoding_cache.encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
+                            maxsat_formula->getPBConstraint(i)->_coeffs,
+                            maxsat_formula->getPBConstraint(i)->_rhs);
   }
 
   // printf("c #Card: %d\n", maxsat_formula->nCard());
   for (int i = 0; i < maxsat_formula->nCard(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
-      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
+      encoding_cache.encodeAMO(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits);
     } else {
-      enc->encodeCardinality(S,
-                             maxsat_formula->getCardinalityConstraint(i)->_lits,
-                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
+      encoding_cache.encodeCardinality(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits,
+          maxsat_formula->getCardinalityConstraint(i)->_rhs);
     }
-
-    delete enc;
   }
 
   vec<Lit> clause;
@@ -865,7 +987,8 @@ Solver *OLL::rebuildSolver() {
   |  Description:
   |
   |    Initializes the relaxation variables by adding a fresh variable to the
-  |    'relaxationVars' of each soft clause.
+  |    'relaxationVars' of each soft clause. Unit soft clauses are relaxed by
+  |    their label instead (see 'MaxSAT::getLabel').
   |
   |  Post-conditions:
   |    * 'objFunction' contains all relaxation variables that were added to soft
@@ -874,7 +997,7 @@ Solver *OLL::rebuildSolver() {
   |________________________________________________________________________________________________@*/
 void OLL::initRelaxation() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
+    Lit l = newRelaxationLiteral(i);
     maxsat_formula->getSoftClause(i).relaxation_vars.push(l);
     maxsat_formula->getSoftClause(i).assumption_var = l;
   }
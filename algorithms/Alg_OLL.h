@@ -35,12 +35,25 @@
 #endif
 
 #include "../Encoder.h"
+#include "../LitMap.h"
 #include "../MaxSAT.h"
 #include <map>
 #include <set>
 
 namespace openwbo {
 
+// Output literal of a soft cardinality constraint: the index of its encoder in
+// 'soft_cardinality', the bound it enforces and its weight.
+struct CardinalityBound {
+  CardinalityBound() : id(0), bound(0), weight(0) {}
+  CardinalityBound(int i, uint64_t b, uint64_t w)
+      : id(i), bound(b), weight(w) {}
+
+  int id;
+  uint64_t bound;
+  uint64_t weight;
+};
+
 //=================================================================================================
 class OLL : public MaxSAT {
 
@@ -52,6 +65,7 @@ public:
     encoding = enc;
     encoder.setCardEncoding(enc);
     min_weight = 1;
+    nbHardened = 0;
   }
   ~OLL() {
     if (solver != NULL)
@@ -88,6 +102,13 @@ protected:
   StatusCode unweighted();
   StatusCode weighted();
 
+  // Relaxes a core of the unweighted algorithm.
+  void relaxCore(vec<Lit> &core, std::set<Lit> &cardinality_assumptions,
+                 vec<Encoder *> &soft_cardinality);
+  // Increases the bound of a new cardinality constraint (core exhaustion).
+  Lit exhaustCore(vec<Encoder *> &soft_cardinality, int id, uint64_t &bound,
+                  uint64_t weight);
+
   Solver *solver;  // SAT Solver used as a black box.
   Encoder encoder; // Interface for the encoder of constraints to CNF.
 
@@ -101,15 +122,11 @@ protected:
   vec<uint64_t> coeffs; // Coefficients of the literals that are used in the
                         // constraint that excludes models.
 
-  std::map<Lit, int> coreMapping; // Mapping between the assumption literal and
-                                  // the respective soft clause.
-
-  std::map<Lit, int>
-      coreCardinality; // Mapping between the assumption literal and
-                       // the respective soft clause.
+  LitMap<int> coreMapping; // Mapping between the assumption literal and
+                           // the respective soft clause.
 
   // lit -> <ID, bound, weight>
-  std::map<Lit, std::pair<std::pair<int, uint64_t>, uint64_t>> boundMapping;
+  LitMap<CardinalityBound> boundMapping;
 
   // Soft clauses that are currently in the MaxSAT formula.
   vec<bool> activeSoft;
@@ -120,6 +137,19 @@ protected:
                           std::set<Lit> &cardinality_assumptions);
 
   uint64_t min_weight;
+
+  // Hardening
+  //
+  // Hardens soft clauses and cardinality outputs whose weight is larger than
+  // 'ubCost' - 'lbCost'.
+  void harden(vec<Lit> &assumptions, vec<Lit> &pending,
+              std::set<Lit> &cardinality_assumptions);
+  uint64_t assumptionWeight(Lit p); // Weight of an assumption literal.
+  // Removes from 'lits' the literals whose variable occurs in 'removed'.
+  void removeLiterals(vec<Lit> &lits, vec<Lit> &removed);
+
+  int nbHardened;     // Number of hardened soft clauses and outputs.
+  vec<bool> varMark;  // Auxiliary marks indexed by variable.
 };
 } // namespace openwbo
 
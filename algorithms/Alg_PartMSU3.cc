@@ -563,6 +563,7 @@ StatusCode PartMSU3::PartMSU3_sequential() {
     }
 
     if (res == l_False) {
+      processCore(solver);
       lbCost++;
       nbCores++;
       if (verbosity > 0)
@@ -573,6 +574,9 @@ StatusCode PartMSU3::PartMSU3_sequential() {
         return _UNSATISFIABLE_;
       }
 
+      if (sharedOptimum())
+        return _OPTIMUM_;
+
       if (lbCost == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
@@ -590,7 +594,7 @@ StatusCode PartMSU3::PartMSU3_sequential() {
 
       joinObjFunction.clear();
       for (int i = 0; i < solver->conflict.size(); i++) {
-        if (coreMapping.find(solver->conflict[i]) != coreMapping.end()) {
+        if (coreMapping.has(solver->conflict[i])) {
           assert(!activeSoft[coreMapping[solver->conflict[i]]]);
           activeSoft[coreMapping[solver->conflict[i]]] = true;
           joinObjFunction.push(
@@ -842,12 +846,17 @@ StatusCode PartMSU3::PartMSU3_binary() {
         return _UNSATISFIABLE_;
       }
 
+      processCore(solver);
+
       current_node->incrementLowerBound();
       lbCost++;
       nbCores++;
       if (verbosity > 0)
         printf("c LB : %-12" PRIu64 "\n", lbCost);
 
+      if (sharedOptimum())
+        return _OPTIMUM_;
+
       if (lbCost == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
@@ -860,7 +869,7 @@ StatusCode PartMSU3::PartMSU3_binary() {
 
       joinObjFunction.clear();
       for (int i = 0; i < solver->conflict.size(); i++) {
-        if (coreMapping.find(solver->conflict[i]) != coreMapping.end()) {
+        if (coreMapping.has(solver->conflict[i])) {
           assert(!activeSoft[coreMapping[solver->conflict[i]]]);
           activeSoft[coreMapping[solver->conflict[i]]] = true;
           joinObjFunction.push(
@@ -928,7 +937,7 @@ StatusCode PartMSU3::search() {
   }
 
   if (incremental_strategy == _INCREMENTAL_ITERATIVE_) {
-    if (encoding != _CARD_TOTALIZER_) {
+    if (encoding != _CARD_TOTALIZER_ && encoding != _CARD_AUTO_) {
       if(print) {
         printf("Error: Currently iterative encoding in PartMSU3 only "
                "supports the Totalizer encoding.\n");
@@ -989,8 +998,11 @@ Solver *PartMSU3::rebuildSolver() {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(getHardClause(i).clause);
+  vec<Lit> hard_clause;
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    getHardClause(i).clause.copyTo(hard_clause);
+    S->addClause(hard_clause);
+  }
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
@@ -1004,36 +1016,25 @@ Solver *PartMSU3::rebuildSolver() {
 
   // printf("c #PB: %d\n", maxsat_formula->nPB());
   for (int i = 0; i < maxsat_formula->nPB(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     // Make sure the PB is on the form <=
     if (!maxsat_formula->getPBConstraint(i)->_sign)
       maxsat_formula->getPBConstraint(i)->changeSign();
 
-    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
-                  maxsat_formula->getPBConstraint(i)->_coeffs,
-                  maxsat_formula->getPBConstraint(i)->_rhs);
-
-    // maxsat_formula->getPBConstraint(i)->print();
-
-    delete enc;
+    encoding_cache.encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
+                            maxsat_formula->getPBConstraint(i)->_coeffs,
+                            maxsat_formula->getPBConstraint(i)->_rhs);
   }
 
   // printf("c #Card: %d\n", maxsat_formula->nCard());
   for (int i = 0; i < maxsat_formula->nCard(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
-      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
+      encoding_cache.encodeAMO(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits);
     } else {
-      enc->encodeCardinality(S,
-                             maxsat_formula->getCardinalityConstraint(i)->_lits,
-                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
+      encoding_cache.encodeCardinality(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits,
+          maxsat_formula->getCardinalityConstraint(i)->_rhs);
     }
-
-    delete enc;
   }
 
   return S;
@@ -1052,7 +1053,8 @@ Solver *PartMSU3::rebuildSolver() {
   |  Description:
   |
   |    Initializes the relaxation variables by adding a fresh variable to the
-  |    'relaxationVars' of each soft clause.
+  |    'relaxationVars' of each soft clause. Unit soft clauses are relaxed by
+  |    their label instead (see 'MaxSAT::getLabel').
   |
   |  Post-conditions:
   |    * 'objFunction' contains all relaxation variables that were added to soft
@@ -1061,7 +1063,7 @@ Solver *PartMSU3::rebuildSolver() {
   |________________________________________________________________________________________________@*/
 void PartMSU3::initRelaxation() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
+    Lit l = newRelaxationLiteral(i);
     getSoftClause(i).relaxation_vars.push(l);
     getSoftClause(i).assumption_var = l;
     objFunction.push(l);
@@ -35,6 +35,7 @@
 #endif
 
 #include "../Encoder.h"
+#include "../LitMap.h"
 #include "../MaxSAT_Partition.h"
 #include <algorithm>
 #include <deque>
@@ -168,8 +169,8 @@ protected:
   vec<int> coeffs; // Coefficients of the literals that are used in the
                    // constraint that excludes models.
 
-  std::map<Lit, int> coreMapping; // Mapping between the assumption literal and
-                                  // the respective soft clause.
+  LitMap<int> coreMapping; // Mapping between the assumption literal and
+                           // the respective soft clause.
 
   // Soft clauses that are currently in the MaxSAT formula.
   vec<bool> activeSoft;
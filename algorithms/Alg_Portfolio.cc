@@ -0,0 +1,233 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "Alg_Portfolio.h"
+
+#include "Alg_LinearSU.h"
+#include "Alg_MSU3.h"
+#include "Alg_OLL.h"
+#include "Alg_PartMSU3.h"
+#include "Alg_WBO.h"
+
+#include <new>
+
+using namespace openwbo;
+
+/************************************************************************************************
+ //
+ // Portfolio of MaxSAT algorithms running in parallel threads
+ //
+ ************************************************************************************************/
+
+// Creates the workers. Each worker solves its own copy of the formula since
+// the algorithms modify it during the search (new soft clauses, weights).
+void Portfolio::createWorkers() {
+  bool weighted = maxsat_formula->getProblemType() == _WEIGHTED_;
+
+  workers.push_back(new WBO(_VERBOSITY_MINIMAL_, _WEIGHT_DIVERSIFY_, true,
+                            500000));
+  names.push_back("WBO");
+  workers.push_back(new LinearSU(_VERBOSITY_MINIMAL_, true, cardinality,
+                                 pb_encoding));
+  names.push_back("LinearSU");
+  workers.push_back(new OLL(_VERBOSITY_MINIMAL_, cardinality));
+  names.push_back("OLL");
+
+  // MSU3 and PartMSU3 do not support weighted formulas.
+  if (!weighted) {
+    workers.push_back(new MSU3(_VERBOSITY_MINIMAL_));
+    names.push_back("MSU3");
+    workers.push_back(new PartMSU3(_VERBOSITY_MINIMAL_, _PART_BINARY_,
+                                   RES_GRAPH, cardinality));
+    names.push_back("PartMSU3");
+  }
+
+  for (int i = 0; i < (int)workers.size(); i++) {
+    workers[i]->loadFormula(maxsat_formula->copyMaxSATFormula());
+    workers[i]->setInitialTime(initialTime);
+    workers[i]->setMaster(this);
+    workers[i]->setBoundBoard(&board);
+    workers[i]->setCoreProcessing(core_trim, core_min_budget);
+    workers[i]->setCoreExhaustion(core_exhaust_budget, disjoint_cores);
+    workers[i]->setLocalSearch(sls_flips);
+    workers[i]->setPreprocessing(preprocess);
+    workers[i]->setResourceLimits(time_limit, mem_limit);
+  }
+}
+
+void Portfolio::runWorker(int i) {
+  StatusCode res;
+  try {
+    res = workers[i]->search();
+  } catch (MaxSATInterrupt &) {
+    res = _UNKNOWN_;
+  } catch (MaxSATException &) {
+    res = _ERROR_;
+  } catch (NSPACE::OutOfMemoryException &) {
+    res = _ERROR_;
+  } catch (std::bad_alloc &) {
+    res = _ERROR_;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  nbFinished++;
+  finish(i, res);
+}
+
+// Records the answer 'res' of worker 'i'. The first definitive answer stops
+// the portfolio. Must be called with 'lock' held.
+void Portfolio::finish(int i, StatusCode res) {
+  // Workers only answer _SATISFIABLE_ for PB formulas without objective.
+  if ((res == _OPTIMUM_ || res == _UNSATISFIABLE_ || res == _SATISFIABLE_) &&
+      result == _UNKNOWN_) {
+    result = res;
+    winner = i;
+  }
+  changed.notify_all();
+}
+
+// Stops the workers, which then finish with an unknown answer. Workers that
+// are created afterwards are stopped by 'search'.
+void Portfolio::interrupt() {
+  MaxSAT::interrupt();
+  std::lock_guard<std::mutex> guard(lock);
+  for (int i = 0; i < (int)workers.size(); i++)
+    workers[i]->interrupt();
+}
+
+// Stops the portfolio as soon as a lower bound reaches the best upper bound.
+void Portfolio::shareLB(MaxSAT *worker, uint64_t bound) {
+  if (!board.isClosed())
+    return;
+
+  std::lock_guard<std::mutex> guard(lock);
+  for (int i = 0; i < (int)workers.size(); i++)
+    if (workers[i] == worker)
+      finish(i, _OPTIMUM_);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  shareModel : (worker : MaxSAT *) (bound : int64_t) ->  [void]
+  |
+  |  Description:
+  |
+  |    Called by 'worker' (from its own thread) whenever it finds a model of
+  |    cost 'bound'. The model is kept if it improves the best upper bound.
+  |
+  |  Post-conditions:
+  |    * 'ubCost' and 'model' are updated if 'bound' is better than 'ubCost'.
+  |
+  |________________________________________________________________________________________________@*/
+void Portfolio::shareModel(MaxSAT *worker, int64_t bound) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (model.size() != 0 && (uint64_t)bound >= ubCost)
+    return;
+
+  ubCost = bound;
+  worker->getModel().copyTo(model);
+  printBound(ubCost + off_set);
+  fflush(stdout);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  search : [void] ->  [StatusCode]
+  |
+  |  Description:
+  |
+  |    Runs WBO, LinearSU, OLL, and for unweighted formulas MSU3 and PartMSU3,
+  |    in parallel threads. The workers exchange their bounds through a
+  |    shared bound board. The best model found by any of them is kept and
+  |    the search stops as soon as one of them proves optimality or
+  |    unsatisfiability, or when the best lower bound meets the best upper
+  |    bound.
+  |
+  |________________________________________________________________________________________________@*/
+StatusCode Portfolio::search() {
+  printConfiguration();
+
+  {
+    // 'interrupt' may be called at any time.
+    std::lock_guard<std::mutex> guard(lock);
+    createWorkers();
+
+    std::lock_guard<std::mutex> stop(interrupt_lock);
+    if (interrupted)
+      for (int i = 0; i < (int)workers.size(); i++)
+        workers[i]->interrupt();
+  }
+
+  for (int i = 0; i < (int)workers.size(); i++)
+    threads.push_back(std::thread(&Portfolio::runWorker, this, i));
+
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    while (result == _UNKNOWN_ && nbFinished < (int)workers.size())
+      changed.wait(guard);
+  }
+
+  for (int i = 0; i < (int)workers.size(); i++)
+    workers[i]->interrupt();
+  for (int i = 0; i < (int)threads.size(); i++)
+    threads[i].join();
+
+  if (result == _OPTIMUM_ || result == _SATISFIABLE_) {
+    // The winner may have found its last model without printing its bound.
+    vec<lbool> &best = workers[winner]->getModel();
+    uint64_t cost = best.size() != 0 ? computeCostModel(best) : UINT64_MAX;
+    if (best.size() != 0 && (model.size() == 0 || cost < ubCost)) {
+      best.copyTo(model);
+      ubCost = cost;
+    }
+  }
+
+  if (verbosity > 0 && print && result != _UNKNOWN_)
+    printf("c Answer found by: %s\n", names[winner]);
+
+  printAnswer(result);
+  return searchStatus;
+}
+
+// Prints the configuration of the portfolio.
+void Portfolio::printConfiguration() {
+  if (!print)
+    return;
+
+  printf("c ==========================================[ Solver Settings "
+         "]============================================\n");
+  printf("c |                                                                "
+         "                                       |\n");
+  printf("c |  Algorithm: %23s                                             "
+         "                      |\n",
+         "Portfolio");
+  print_Card_configuration(cardinality);
+  print_PB_configuration(pb_encoding);
+  printf("c |                                                                "
+         "                                       |\n");
+}
@@ -0,0 +1,97 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#ifndef Alg_Portfolio_h
+#define Alg_Portfolio_h
+
+#include "../MaxSAT.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openwbo {
+
+//=================================================================================================
+class Portfolio : public MaxSAT {
+
+public:
+  Portfolio(int verb = _VERBOSITY_MINIMAL_, int card = _CARD_TOTALIZER_,
+            int pb = _PB_GTE_) {
+    verbosity = verb;
+    cardinality = card;
+    pb_encoding = pb;
+    nbFinished = 0;
+    result = _UNKNOWN_;
+  }
+
+  ~Portfolio() {
+    for (int i = 0; i < (int)workers.size(); i++)
+      delete workers[i];
+  }
+
+  StatusCode search(); // Portfolio search.
+
+  // Receives the upper bounds found by the workers.
+  void shareModel(MaxSAT *worker, int64_t bound);
+
+  // Receives the lower bounds found by the workers.
+  void shareLB(MaxSAT *worker, uint64_t bound);
+
+  // Stops all workers.
+  void interrupt();
+
+  // Local search is done by each worker on its own models.
+  void setLocalSearch(int flips) { sls_flips = flips; }
+
+  // Print solver configuration.
+  void printConfiguration();
+
+protected:
+  void createWorkers(); // Creates one worker per applicable algorithm.
+  void runWorker(int i);   // Thread body of worker 'i'.
+  void finish(int i, StatusCode res); // Records the answer of worker 'i'.
+
+  int cardinality; // Cardinality encoding used by the workers.
+  int pb_encoding; // PB encoding used by the workers.
+
+  std::vector<MaxSAT *> workers;       // Algorithms running in parallel.
+  std::vector<const char *> names;     // Names of the algorithms.
+  std::vector<std::thread> threads;    // One thread per worker.
+  BoundBoard board;                    // Bounds shared by the workers.
+
+  std::mutex lock;                 // Protects the shared state below.
+  std::condition_variable changed; // Signaled when a worker finishes.
+  int nbFinished;                  // Number of workers that have finished.
+  StatusCode result;               // Definitive answer (if any).
+  int winner;                      // Worker that gave the definitive answer.
+};
+} // namespace openwbo
+
+#endif
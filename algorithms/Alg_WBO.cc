@@ -37,14 +37,15 @@ using namespace openwbo;
 
 /*_________________________________________________________________________________________________
   |
-  |  rebuildWeightSolver : (strategy : int)  ->  [Solver *]
+  |  updateSolver : [void]  ->  [void]
   |
-  |   Description:
+  |  Description:
   |
-  |    Rebuilds a SAT solver with the current MaxSAT formula using a
-  |    weight-based strategy.
-  |    Only soft clauses with weight greater or equal to 'currentWeight' are
-  |    considered in the working MaxSAT formula.
+  |    Brings 'solver' up to date with the working MaxSAT formula without
+  |    rebuilding it. New hard clauses are added, soft clauses relaxed by
+  |    'relaxCore' are replaced by a copy with the new relaxation variables,
+  |    and soft clauses enter or leave the working formula as 'currentWeight'
+  |    changes. Learnt clauses are kept since clauses are only added.
   |
   |   For further details see:
   |     * Ruben Martins, Vasco Manquinho, Inês Lynce: On Partitioning for
@@ -54,161 +55,61 @@ using namespace openwbo;
   |
   |   Pre-conditions:
   |     * Assumes that 'currentWeight' has been previously updated.
-  |     * Assumes that the weight strategy is either '_WEIGHT_NORMAL_' or
-  |       '_WEIGHT_DIVERSIFY_'.
   |
   |   Post-conditions:
   |     * 'nbCurrentSoft' is updated to the number of soft clauses in the
   |        working MaxSAT formula.
+  |     * 'assumptions' and 'coreMapping' are updated with the assumption
+  |        literals of all soft clauses that were ever in the working formula.
   |
   |________________________________________________________________________________________________@*/
-Solver *WBO::rebuildWeightSolver(int strategy) {
-
-  assert(strategy == _WEIGHT_NORMAL_ || strategy == _WEIGHT_DIVERSIFY_);
-
-  Solver *S = newSATSolver();
-
-  reserveSATVariables(S, maxsat_formula->nVars());
+void WBO::updateSolver() {
 
-  for (int i = 0; i < maxsat_formula->nVars(); i++)
-    newSATVariable(S);
-
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
+  syncSATVariables(solver);
+  vec<Lit> hard_clause;
+  for (; nbHardSolver < maxsat_formula->nHard(); nbHardSolver++) {
+    maxsat_formula->getHardClause(nbHardSolver).clause.copyTo(hard_clause);
+    solver->addClause(hard_clause);
+  }
 
+  // Symmetry breaking clauses are added to the solver in the next update.
   if (symmetryStrategy)
     symmetryBreaking();
 
-  vec<Lit> clause;
-  nbCurrentSoft = 0;
-  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    if (maxsat_formula->getSoftClause(i).weight >=
-        maxsat_formula->getMaximumWeight()) {
-      nbCurrentSoft++;
-      clause.clear();
-      maxsat_formula->getSoftClause(i).clause.copyTo(clause);
-      for (int j = 0;
-           j < maxsat_formula->getSoftClause(i).relaxation_vars.size(); j++)
-        clause.push(maxsat_formula->getSoftClause(i).relaxation_vars[j]);
-
-      clause.push(maxsat_formula->getSoftClause(i).assumption_var);
-      S->addClause(clause);
+  activeSoft.growTo(maxsat_formula->nSoft(), false);
+  for (int i = 0; i < relaxedSoft.size(); i++) {
+    if (activeSoft[relaxedSoft[i]]) {
+      deactivateSoftClause(solver, relaxedSoft[i]);
+      activeSoft[relaxedSoft[i]] = false;
     }
   }
+  relaxedSoft.clear();
 
-  // printf("c #PB: %d\n", maxsat_formula->nPB());
-  for (int i = 0; i < maxsat_formula->nPB(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
-    // Make sure the PB is on the form <=
-    if (!maxsat_formula->getPBConstraint(i)->_sign)
-      maxsat_formula->getPBConstraint(i)->changeSign();
-
-    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
-                  maxsat_formula->getPBConstraint(i)->_coeffs,
-                  maxsat_formula->getPBConstraint(i)->_rhs);
-
-    // maxsat_formula->getPBConstraint(i)->print();
-
-    delete enc;
-  }
-
-  // printf("c #Card: %d\n", maxsat_formula->nCard());
-  for (int i = 0; i < maxsat_formula->nCard(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
-    if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
-      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
-    } else {
-      enc->encodeCardinality(S,
-                             maxsat_formula->getCardinalityConstraint(i)->_lits,
-                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
+  nbCurrentSoft = 0;
+  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    bool working = weightStrategy == _WEIGHT_NONE_ ||
+                   maxsat_formula->getSoftClause(i).weight >= currentWeight;
+    if (activeSoft[i] && !working) {
+      deactivateSoftClause(solver, i);
+      activeSoft[i] = false;
+    } else if (!activeSoft[i] && working) {
+      activateSoftClause(solver, i);
+      activeSoft[i] = true;
     }
-
-    delete enc;
+    if (working)
+      nbCurrentSoft++;
   }
-  return S;
-}
 
-/*_________________________________________________________________________________________________
-  |
-  |  rebuildSolver : [void]  ->  [Solver *]
-  |
-  |  Description:
-  |
-  |    Rebuilds a SAT solver with the current MaxSAT formula using the original
-  |    WBO strategy.
-  |    All soft clauses are considered in the working formula.
-  |
-  |  Pre-conditions:
-  |    * Assumes that the weight strategy is '_WEIGHT_NONE_'.
-  |
-  |________________________________________________________________________________________________@*/
-Solver *WBO::rebuildSolver() {
-
-  assert(weightStrategy == _WEIGHT_NONE_);
-
-  Solver *S = newSATSolver();
-
-  reserveSATVariables(S, maxsat_formula->nVars());
-
-  for (int i = 0; i < maxsat_formula->nVars(); i++)
-    newSATVariable(S);
-
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
-
-  if (symmetryStrategy)
-    symmetryBreaking();
-
-  vec<Lit> clause;
+  // Soft clauses get their assumption literal (possibly their label) when
+  // they are first activated.
+  assumptions.clear();
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    clause.clear();
-    maxsat_formula->getSoftClause(i).clause.copyTo(clause);
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).relaxation_vars.size();
-         j++)
-      clause.push(maxsat_formula->getSoftClause(i).relaxation_vars[j]);
-    clause.push(maxsat_formula->getSoftClause(i).assumption_var);
-
-    S->addClause(clause);
-  }
-
-  // printf("c #PB: %d\n", maxsat_formula->nPB());
-  for (int i = 0; i < maxsat_formula->nPB(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
-    // Make sure the PB is on the form <=
-    if (!maxsat_formula->getPBConstraint(i)->_sign)
-      maxsat_formula->getPBConstraint(i)->changeSign();
-
-    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
-                  maxsat_formula->getPBConstraint(i)->_coeffs,
-                  maxsat_formula->getPBConstraint(i)->_rhs);
-
-    // maxsat_formula->getPBConstraint(i)->print();
-
-    delete enc;
-  }
-
-  // printf("c #Card: %d\n", maxsat_formula->nCard());
-  for (int i = 0; i < maxsat_formula->nCard(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
-    if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
-      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
-    } else {
-      enc->encodeCardinality(S,
-                             maxsat_formula->getCardinalityConstraint(i)->_lits,
-                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
-    }
-
-    delete enc;
+    Lit l = maxsat_formula->getSoftClause(i).assumption_var;
+    if (l == lit_Undef)
+      continue;
+    coreMapping[l] = i;
+    assumptions.push(~l);
   }
-  return S;
 }
 
 /*_________________________________________________________________________________________________
@@ -230,41 +131,35 @@ Solver *WBO::rebuildHardSolver() {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
+  vec<Lit> hard_clause;
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    maxsat_formula->getHardClause(i).clause.copyTo(hard_clause);
+    S->addClause(hard_clause);
+  }
 
   // printf("c #PB: %d\n", maxsat_formula->nPB());
   for (int i = 0; i < maxsat_formula->nPB(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     // Make sure the PB is on the form <=
     if (!maxsat_formula->getPBConstraint(i)->_sign)
       maxsat_formula->getPBConstraint(i)->changeSign();
 
-    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
-                  maxsat_formula->getPBConstraint(i)->_coeffs,
-                  maxsat_formula->getPBConstraint(i)->_rhs);
+    encoding_cache.encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
+                            maxsat_formula->getPBConstraint(i)->_coeffs,
+                            maxsat_formula->getPBConstraint(i)->_rhs);
 
     // maxsat_formula->getPBConstraint(i)->print();
-
-    delete enc;
   }
 
   // printf("c #Card: %d\n", maxsat_formula->nCard());
   for (int i = 0; i < maxsat_formula->nCard(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
     if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
-      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
+      encoding_cache.encodeAMO(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits);
     } else {
-      enc->encodeCardinality(S,
-                             maxsat_formula->getCardinalityConstraint(i)->_lits,
-                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
+      encoding_cache.encodeCardinality(
+          S, maxsat_formula->getCardinalityConstraint(i)->_lits,
+          maxsat_formula->getCardinalityConstraint(i)->_rhs);
     }
-
-    delete enc;
   }
 
   return S;
@@ -291,11 +186,9 @@ void WBO::updateCurrentWeight(int strategy) {
   assert(strategy == _WEIGHT_NORMAL_ || strategy == _WEIGHT_DIVERSIFY_);
 
   if (strategy == _WEIGHT_NORMAL_)
-    maxsat_formula->setMaximumWeight(
-        findNextWeight(maxsat_formula->getMaximumWeight()));
+    currentWeight = findNextWeight(currentWeight);
   else if (strategy == _WEIGHT_DIVERSIFY_)
-    maxsat_formula->setMaximumWeight(
-        findNextWeightDiversity(maxsat_formula->getMaximumWeight()));
+    currentWeight = findNextWeightDiversity(currentWeight);
 }
 
 /*_________________________________________________________________________________________________
@@ -524,6 +417,7 @@ void WBO::relaxCore(const vec<Lit> &conflict, uint64_t weightCore,
       Lit p = maxsat_formula->newLiteral();
       maxsat_formula->getSoftClause(indexSoft).relaxation_vars.push(p);
       lits.push(p);
+      relaxedSoft.push(indexSoft);
 
       if (symmetryStrategy)
         symmetryLog(indexSoft);
@@ -820,8 +714,10 @@ StatusCode WBO::unsatSearch() {
     printBound(ubCost);
   }
 
-  delete solver;
-  solver = NULL;
+  // The same solver is used by the search. Variables created by the encoders
+  // are reserved in the formula before any assumption literal is created.
+  syncSATVariables(solver);
+  nbHardSolver = maxsat_formula->nHard();
   return _SATISFIABLE_;
 }
 
@@ -855,11 +751,11 @@ StatusCode WBO::weightSearch() {
   assert(weightStrategy == _WEIGHT_NORMAL_ ||
          weightStrategy == _WEIGHT_DIVERSIFY_);
 
-  unsatSearch();
+  if (unsatSearch() == _UNSATISFIABLE_)
+    return _UNSATISFIABLE_;
 
-  initAssumptions(assumptions);
   updateCurrentWeight(weightStrategy);
-  solver = rebuildWeightSolver(weightStrategy);
+  updateSolver();
 
   for (;;) {
 
@@ -868,14 +764,18 @@ StatusCode WBO::weightSearch() {
     if (res == l_False) {
       nbCores++;
       assert(solver->conflict.size() > 0);
+      processCore(solver);
       uint64_t coreCost = computeCostCore(solver->conflict);
       lbCost += coreCost;
       if (verbosity > 0)
         printf("c LB : %-12" PRIu64 " CS : %-12d W  : %-12" PRIu64 "\n", lbCost,
                solver->conflict.size(), coreCost);
+
+      if (sharedOptimum())
+        return _OPTIMUM_;
+
       relaxCore(solver->conflict, coreCost, assumptions);
-      delete solver;
-      solver = rebuildWeightSolver(weightStrategy);
+      updateSolver();
     }
 
     if (res == l_True) {
@@ -907,8 +807,7 @@ StatusCode WBO::weightSearch() {
           return _OPTIMUM_;
         }
 
-        delete solver;
-        solver = rebuildWeightSolver(weightStrategy);
+        updateSolver();
       }
     }
   }
@@ -935,10 +834,10 @@ StatusCode WBO::weightSearch() {
   |________________________________________________________________________________________________@*/
 StatusCode WBO::normalSearch() {
 
-  unsatSearch();
+  if (unsatSearch() == _UNSATISFIABLE_)
+    return _UNSATISFIABLE_;
 
-  initAssumptions(assumptions);
-  solver = rebuildSolver();
+  updateSolver();
 
   for (;;) {
 
@@ -947,12 +846,16 @@ StatusCode WBO::normalSearch() {
     if (res == l_False) {
       nbCores++;
       assert(solver->conflict.size() > 0);
+      processCore(solver);
       uint64_t coreCost = computeCostCore(solver->conflict);
       lbCost += coreCost;
       if (verbosity > 0)
         printf("c LB : %-12" PRIu64 " CS : %-12d W  : %-12" PRIu64 "\n", lbCost,
                solver->conflict.size(), coreCost);
 
+      if (sharedOptimum())
+        return _OPTIMUM_;
+
       if (lbCost == ubCost) {
         if (verbosity > 0)
           printf("c LB = UB\n");
@@ -961,16 +864,15 @@ StatusCode WBO::normalSearch() {
       }
 
       relaxCore(solver->conflict, coreCost, assumptions);
-      delete solver;
-      solver = rebuildSolver();
+      updateSolver();
     }
 
     if (res == l_True) {
       nbSatisfiable++;
       ubCost = computeCostModel(solver->model);
       assert(lbCost == ubCost);
-      printBound(lbCost);
       saveModel(solver->model);
+      printBound(lbCost);
       printAnswer(_OPTIMUM_);
       return _OPTIMUM_;
     }
@@ -989,6 +891,7 @@ StatusCode WBO::search() {
   // }
   if (maxsat_formula->getMaximumWeight() == 1)
     weightStrategy = _WEIGHT_NONE_;
+  currentWeight = maxsat_formula->getMaximumWeight();
 
   if (symmetryStrategy)
     initSymmetry();
@@ -1003,36 +906,3 @@ StatusCode WBO::search() {
   // this line should not be reached
   return _ERROR_;
 }
-
-/************************************************************************************************
- //
- // Other protected methods
- //
- ************************************************************************************************/
-
-/*_________________________________________________________________________________________________
-  |
-  |  initAssumptions : (assumps : vec<Lit>&) ->  [void]
-  |
-  |  Description:
-  |
-  |    Creates a new assumption literal for each soft clause and initializes the
-  |    assumption vector with negation of this literal. Assumptions are used to
-  |    extract cores.
-  |
-  |  Post-conditions:
-  |    * For each soft clause 'i' creates an assumption literal and assigns it
-  |      to 'softClauses[i].assumptionVar'.
-  |    * 'coreMapping' is updated by mapping each assumption literal with the
-  |      corresponding index of each soft clause.
-  |    * 'assumps' is updates with the assumptions literals.
-  |
-  |________________________________________________________________________________________________@*/
-void WBO::initAssumptions(vec<Lit> &assumps) {
-  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
-    maxsat_formula->getSoftClause(i).assumption_var = l;
-    coreMapping[l] = i;
-    assumps.push(~l);
-  }
-}
@@ -35,6 +35,7 @@
 #endif
 
 #include "../Encoder.h"
+#include "../LitMap.h"
 #include "../MaxSAT.h"
 #include "../MaxTypes.h"
 #include "utils/System.h"
@@ -55,6 +56,8 @@ public:
 
     nbCurrentSoft = 0;
     weightStrategy = weight;
+    nbHardSolver = 0;
+    currentWeight = 0;
 
     symmetryStrategy = symmetry;
     symmetryBreakingLimit = limit;
@@ -70,10 +73,8 @@ public:
 protected:
   // Rebuild MaxSAT solver
   //
-  // Rebuild MaxSAT solver with weight-based strategy.
-  Solver *rebuildWeightSolver(int strategy);
-  Solver *rebuildSolver();     // Rebuild MaxSAT solver.
   Solver *rebuildHardSolver(); // Rebuild MaxSAT solver with only hard clauses.
+  void updateSolver(); // Updates the SAT solver with the working formula.
   void updateCurrentWeight(int strategy); // Updates 'currentWeight'.
   uint64_t
   findNextWeight(uint64_t weight); // Finds the next weight for 'currentWeight'.
@@ -101,10 +102,6 @@ protected:
   StatusCode weightSearch(); // Search using weight-based methods.
   StatusCode normalSearch(); // Original WBO search.
 
-  // Other
-  // Initializes assumptions and core extraction.
-  void initAssumptions(vec<Lit> &assumps);
-
   // SAT solver
   Solver *solver;  // SAT solver used as a black box.
   Encoder encoder; // Interface for the encoder of constraints to CNF.
@@ -114,11 +111,19 @@ protected:
   int nbCurrentSoft;  // Current number of soft clauses used by the MaxSAT
                       // solver.
   int weightStrategy; // Weight strategy to be used in 'weightSearch'.
+  uint64_t currentWeight; // Soft clauses with a smaller weight are not in the
+                          // working formula.
+
+  // Working formula in the SAT solver
+  //
+  int nbHardSolver;      // Number of hard clauses in 'solver'.
+  vec<bool> activeSoft;  // Soft clauses in the working formula of 'solver'.
+  vec<int> relaxedSoft;  // Soft clauses relaxed since the last update.
 
   // Core extraction
   //
-  std::map<Lit, int> coreMapping; // Maps the assumption literal to the number
-                                  // of the soft clause.
+  LitMap<int> coreMapping; // Maps the assumption literal to the number
+                           // of the soft clause.
   vec<Lit> assumptions; // Stores the assumptions to be used in the extraction
                         // of the core.
 
@@ -0,0 +1,198 @@
+/root/repo/Encoder.o /root/repo/Encoder.or /root/repo/Encoder.od /root/repo/Encoder.op: /root/repo/Encoder.cc /root/repo/Encoder.h \
+ /root/repo/solvers/glucose4.1/core/Solver.h \
+ /root/repo/solvers/glucose4.1/mtl/Heap.h \
+ /root/repo/solvers/glucose4.1/mtl/Vec.h \
+ /root/repo/solvers/glucose4.1/mtl/IntTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/XAlloc.h \
+ /root/repo/solvers/glucose4.1/mtl/Alg.h \
+ /root/repo/solvers/glucose4.1/utils/Options.h \
+ /root/repo/solvers/glucose4.1/utils/ParseUtils.h \
+ /root/repo/solvers/glucose4.1/core/SolverTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Map.h \
+ /root/repo/solvers/glucose4.1/mtl/Alloc.h \
+ /root/repo/solvers/glucose4.1/core/BoundedQueue.h \
+ /root/repo/solvers/glucose4.1/core/Constants.h \
+ /root/repo/solvers/glucose4.1/mtl/Clone.h \
+ /root/repo/solvers/glucose4.1/core/SolverStats.h /root/repo/MaxTypes.h \
+ /root/repo/encodings/Enc_CNetworks.h /root/repo/encodings/Encodings.h \
+ /root/repo/encodings/../MaxTypes.h /root/repo/encodings/Enc_GTE.h \
+ /root/repo/encodings/Enc_Ladder.h /root/repo/encodings/Enc_MTotalizer.h \
+ /root/repo/encodings/Enc_SWC.h /root/repo/encodings/Enc_Totalizer.h \
+ /root/repo/encodings/Enc_Adder.h
+/root/repo/EncodingCache.o /root/repo/EncodingCache.or /root/repo/EncodingCache.od /root/repo/EncodingCache.op: /root/repo/EncodingCache.cc /root/repo/EncodingCache.h \
+ /root/repo/solvers/glucose4.1/core/Solver.h \
+ /root/repo/solvers/glucose4.1/mtl/Heap.h \
+ /root/repo/solvers/glucose4.1/mtl/Vec.h \
+ /root/repo/solvers/glucose4.1/mtl/IntTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/XAlloc.h \
+ /root/repo/solvers/glucose4.1/mtl/Alg.h \
+ /root/repo/solvers/glucose4.1/utils/Options.h \
+ /root/repo/solvers/glucose4.1/utils/ParseUtils.h \
+ /root/repo/solvers/glucose4.1/core/SolverTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Map.h \
+ /root/repo/solvers/glucose4.1/mtl/Alloc.h \
+ /root/repo/solvers/glucose4.1/core/BoundedQueue.h \
+ /root/repo/solvers/glucose4.1/core/Constants.h \
+ /root/repo/solvers/glucose4.1/mtl/Clone.h \
+ /root/repo/solvers/glucose4.1/core/SolverStats.h /root/repo/Encoder.h \
+ /root/repo/MaxTypes.h /root/repo/encodings/Enc_CNetworks.h \
+ /root/repo/encodings/Encodings.h /root/repo/encodings/../MaxTypes.h \
+ /root/repo/encodings/Enc_GTE.h /root/repo/encodings/Enc_Ladder.h \
+ /root/repo/encodings/Enc_MTotalizer.h /root/repo/encodings/Enc_SWC.h \
+ /root/repo/encodings/Enc_Totalizer.h /root/repo/encodings/Enc_Adder.h
+/root/repo/LocalSearch.o /root/repo/LocalSearch.or /root/repo/LocalSearch.od /root/repo/LocalSearch.op: /root/repo/LocalSearch.cc /root/repo/LocalSearch.h \
+ /root/repo/solvers/glucose4.1/core/Solver.h \
+ /root/repo/solvers/glucose4.1/mtl/Heap.h \
+ /root/repo/solvers/glucose4.1/mtl/Vec.h \
+ /root/repo/solvers/glucose4.1/mtl/IntTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/XAlloc.h \
+ /root/repo/solvers/glucose4.1/mtl/Alg.h \
+ /root/repo/solvers/glucose4.1/utils/Options.h \
+ /root/repo/solvers/glucose4.1/utils/ParseUtils.h \
+ /root/repo/solvers/glucose4.1/core/SolverTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Map.h \
+ /root/repo/solvers/glucose4.1/mtl/Alloc.h \
+ /root/repo/solvers/glucose4.1/core/BoundedQueue.h \
+ /root/repo/solvers/glucose4.1/core/Constants.h \
+ /root/repo/solvers/glucose4.1/mtl/Clone.h \
+ /root/repo/solvers/glucose4.1/core/SolverStats.h \
+ /root/repo/MaxSATFormula.h /root/repo/FormulaPB.h /root/repo/MaxTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Sort.h
+/root/repo/Main.o /root/repo/Main.or /root/repo/Main.od /root/repo/Main.op: /root/repo/Main.cc /root/repo/solvers/glucose4.1/utils/Options.h \
+ /root/repo/solvers/glucose4.1/mtl/IntTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Vec.h \
+ /root/repo/solvers/glucose4.1/mtl/XAlloc.h \
+ /root/repo/solvers/glucose4.1/utils/ParseUtils.h \
+ /root/repo/solvers/glucose4.1/utils/System.h \
+ /root/repo/solvers/glucose4.1/core/Solver.h \
+ /root/repo/solvers/glucose4.1/mtl/Heap.h \
+ /root/repo/solvers/glucose4.1/mtl/Alg.h \
+ /root/repo/solvers/glucose4.1/core/SolverTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Map.h \
+ /root/repo/solvers/glucose4.1/mtl/Alloc.h \
+ /root/repo/solvers/glucose4.1/core/BoundedQueue.h \
+ /root/repo/solvers/glucose4.1/core/Constants.h \
+ /root/repo/solvers/glucose4.1/mtl/Clone.h \
+ /root/repo/solvers/glucose4.1/core/SolverStats.h /root/repo/MaxSAT.h \
+ /root/repo/BoundBoard.h /root/repo/EncodingCache.h /root/repo/Encoder.h \
+ /root/repo/MaxTypes.h /root/repo/encodings/Enc_CNetworks.h \
+ /root/repo/encodings/Encodings.h /root/repo/encodings/../MaxTypes.h \
+ /root/repo/encodings/Enc_GTE.h /root/repo/encodings/Enc_Ladder.h \
+ /root/repo/encodings/Enc_MTotalizer.h /root/repo/encodings/Enc_SWC.h \
+ /root/repo/encodings/Enc_Totalizer.h /root/repo/encodings/Enc_Adder.h \
+ /root/repo/LocalSearch.h /root/repo/MaxSATFormula.h \
+ /root/repo/FormulaPB.h /root/repo/Preprocessor.h \
+ /root/repo/ParserMaxSAT.h /root/repo/ParserPB.h \
+ /root/repo/algorithms/Alg_LinearSU.h /root/repo/algorithms/../Encoder.h \
+ /root/repo/algorithms/../MaxSAT.h /root/repo/algorithms/Alg_MSU3.h \
+ /root/repo/algorithms/../LitMap.h /root/repo/algorithms/Alg_OLL.h \
+ /root/repo/algorithms/Alg_PartMSU3.h \
+ /root/repo/algorithms/../MaxSAT_Partition.h \
+ /root/repo/algorithms/../MaxSAT.h /root/repo/algorithms/../graph/Graph.h \
+ /root/repo/algorithms/../graph/Graph_Communities.h \
+ /root/repo/algorithms/../graph/Graph.h \
+ /root/repo/algorithms/Alg_Portfolio.h /root/repo/algorithms/Alg_WBO.h \
+ /root/repo/algorithms/../MaxTypes.h
+/root/repo/MaxSAT.o /root/repo/MaxSAT.or /root/repo/MaxSAT.od /root/repo/MaxSAT.op: /root/repo/MaxSAT.cc /root/repo/MaxSAT.h \
+ /root/repo/solvers/glucose4.1/core/Solver.h \
+ /root/repo/solvers/glucose4.1/mtl/Heap.h \
+ /root/repo/solvers/glucose4.1/mtl/Vec.h \
+ /root/repo/solvers/glucose4.1/mtl/IntTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/XAlloc.h \
+ /root/repo/solvers/glucose4.1/mtl/Alg.h \
+ /root/repo/solvers/glucose4.1/utils/Options.h \
+ /root/repo/solvers/glucose4.1/utils/ParseUtils.h \
+ /root/repo/solvers/glucose4.1/core/SolverTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Map.h \
+ /root/repo/solvers/glucose4.1/mtl/Alloc.h \
+ /root/repo/solvers/glucose4.1/core/BoundedQueue.h \
+ /root/repo/solvers/glucose4.1/core/Constants.h \
+ /root/repo/solvers/glucose4.1/mtl/Clone.h \
+ /root/repo/solvers/glucose4.1/core/SolverStats.h /root/repo/BoundBoard.h \
+ /root/repo/EncodingCache.h /root/repo/Encoder.h /root/repo/MaxTypes.h \
+ /root/repo/encodings/Enc_CNetworks.h /root/repo/encodings/Encodings.h \
+ /root/repo/encodings/../MaxTypes.h /root/repo/encodings/Enc_GTE.h \
+ /root/repo/encodings/Enc_Ladder.h /root/repo/encodings/Enc_MTotalizer.h \
+ /root/repo/encodings/Enc_SWC.h /root/repo/encodings/Enc_Totalizer.h \
+ /root/repo/encodings/Enc_Adder.h /root/repo/LocalSearch.h \
+ /root/repo/MaxSATFormula.h /root/repo/FormulaPB.h \
+ /root/repo/Preprocessor.h /root/repo/solvers/glucose4.1/utils/System.h
+/root/repo/MaxSATFormula.o /root/repo/MaxSATFormula.or /root/repo/MaxSATFormula.od /root/repo/MaxSATFormula.op: /root/repo/MaxSATFormula.cc /root/repo/MaxSATFormula.h \
+ /root/repo/solvers/glucose4.1/core/Solver.h \
+ /root/repo/solvers/glucose4.1/mtl/Heap.h \
+ /root/repo/solvers/glucose4.1/mtl/Vec.h \
+ /root/repo/solvers/glucose4.1/mtl/IntTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/XAlloc.h \
+ /root/repo/solvers/glucose4.1/mtl/Alg.h \
+ /root/repo/solvers/glucose4.1/utils/Options.h \
+ /root/repo/solvers/glucose4.1/utils/ParseUtils.h \
+ /root/repo/solvers/glucose4.1/core/SolverTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Map.h \
+ /root/repo/solvers/glucose4.1/mtl/Alloc.h \
+ /root/repo/solvers/glucose4.1/core/BoundedQueue.h \
+ /root/repo/solvers/glucose4.1/core/Constants.h \
+ /root/repo/solvers/glucose4.1/mtl/Clone.h \
+ /root/repo/solvers/glucose4.1/core/SolverStats.h /root/repo/FormulaPB.h \
+ /root/repo/MaxTypes.h
+/root/repo/MaxSAT_Partition.o /root/repo/MaxSAT_Partition.or /root/repo/MaxSAT_Partition.od /root/repo/MaxSAT_Partition.op: /root/repo/MaxSAT_Partition.cc \
+ /root/repo/solvers/glucose4.1/core/SolverTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/IntTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Alg.h \
+ /root/repo/solvers/glucose4.1/mtl/Vec.h \
+ /root/repo/solvers/glucose4.1/mtl/XAlloc.h \
+ /root/repo/solvers/glucose4.1/mtl/Map.h \
+ /root/repo/solvers/glucose4.1/mtl/Alloc.h /root/repo/MaxSAT_Partition.h \
+ /root/repo/MaxSAT.h /root/repo/solvers/glucose4.1/core/Solver.h \
+ /root/repo/solvers/glucose4.1/mtl/Heap.h \
+ /root/repo/solvers/glucose4.1/utils/Options.h \
+ /root/repo/solvers/glucose4.1/utils/ParseUtils.h \
+ /root/repo/solvers/glucose4.1/core/BoundedQueue.h \
+ /root/repo/solvers/glucose4.1/core/Constants.h \
+ /root/repo/solvers/glucose4.1/mtl/Clone.h \
+ /root/repo/solvers/glucose4.1/core/SolverStats.h /root/repo/BoundBoard.h \
+ /root/repo/EncodingCache.h /root/repo/Encoder.h /root/repo/MaxTypes.h \
+ /root/repo/encodings/Enc_CNetworks.h /root/repo/encodings/Encodings.h \
+ /root/repo/encodings/../MaxTypes.h /root/repo/encodings/Enc_GTE.h \
+ /root/repo/encodings/Enc_Ladder.h /root/repo/encodings/Enc_MTotalizer.h \
+ /root/repo/encodings/Enc_SWC.h /root/repo/encodings/Enc_Totalizer.h \
+ /root/repo/encodings/Enc_Adder.h /root/repo/LocalSearch.h \
+ /root/repo/MaxSATFormula.h /root/repo/FormulaPB.h \
+ /root/repo/Preprocessor.h /root/repo/solvers/glucose4.1/utils/System.h \
+ /root/repo/graph/Graph.h /root/repo/graph/Graph_Communities.h \
+ /root/repo/graph/Graph.h
+/root/repo/ParserPB.o /root/repo/ParserPB.or /root/repo/ParserPB.od /root/repo/ParserPB.op: /root/repo/ParserPB.cc /root/repo/ParserPB.h \
+ /root/repo/MaxSATFormula.h /root/repo/solvers/glucose4.1/core/Solver.h \
+ /root/repo/solvers/glucose4.1/mtl/Heap.h \
+ /root/repo/solvers/glucose4.1/mtl/Vec.h \
+ /root/repo/solvers/glucose4.1/mtl/IntTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/XAlloc.h \
+ /root/repo/solvers/glucose4.1/mtl/Alg.h \
+ /root/repo/solvers/glucose4.1/utils/Options.h \
+ /root/repo/solvers/glucose4.1/utils/ParseUtils.h \
+ /root/repo/solvers/glucose4.1/core/SolverTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Map.h \
+ /root/repo/solvers/glucose4.1/mtl/Alloc.h \
+ /root/repo/solvers/glucose4.1/core/BoundedQueue.h \
+ /root/repo/solvers/glucose4.1/core/Constants.h \
+ /root/repo/solvers/glucose4.1/mtl/Clone.h \
+ /root/repo/solvers/glucose4.1/core/SolverStats.h /root/repo/FormulaPB.h \
+ /root/repo/MaxTypes.h
+/root/repo/Preprocessor.o /root/repo/Preprocessor.or /root/repo/Preprocessor.od /root/repo/Preprocessor.op: /root/repo/Preprocessor.cc /root/repo/Preprocessor.h \
+ /root/repo/solvers/glucose4.1/core/Solver.h \
+ /root/repo/solvers/glucose4.1/mtl/Heap.h \
+ /root/repo/solvers/glucose4.1/mtl/Vec.h \
+ /root/repo/solvers/glucose4.1/mtl/IntTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/XAlloc.h \
+ /root/repo/solvers/glucose4.1/mtl/Alg.h \
+ /root/repo/solvers/glucose4.1/utils/Options.h \
+ /root/repo/solvers/glucose4.1/utils/ParseUtils.h \
+ /root/repo/solvers/glucose4.1/core/SolverTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Map.h \
+ /root/repo/solvers/glucose4.1/mtl/Alloc.h \
+ /root/repo/solvers/glucose4.1/core/BoundedQueue.h \
+ /root/repo/solvers/glucose4.1/core/Constants.h \
+ /root/repo/solvers/glucose4.1/mtl/Clone.h \
+ /root/repo/solvers/glucose4.1/core/SolverStats.h \
+ /root/repo/MaxSATFormula.h /root/repo/FormulaPB.h /root/repo/MaxTypes.h \
+ /root/repo/solvers/glucose4.1/mtl/Sort.h \
+ /root/repo/solvers/glucose4.1/utils/System.h
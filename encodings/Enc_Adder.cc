@@ -190,7 +190,7 @@ void Adder::lessThanOrEqual (Solver *S, vec< Lit > & xs, std::vector< uint64_t >
       clause.push ( ~xs[i] );
 
       //formula.addClause( clause );
-      S->addClause(clause);
+      addClause(S, clause);
       }
 
 }
@@ -239,7 +239,7 @@ void Adder::lessThanOrEqualInc (Solver *S, vec< Lit > & xs, std::vector< uint64_
       Lit t = mkLit(S->newVar(), false);
       clause.push(t);
       assumptions.push(~t);
-      S->addClause(clause);
+      addClause(S, clause);
       }
 
 }
@@ -265,6 +265,26 @@ void Adder::numToBits ( std::vector<uint64_t> & bits, uint64_t n, uint64_t numbe
 void Adder::encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs){
 
     _output.clear();
+    _buckets.clear();
+    hasEncoding = false;
+
+    // Only the bits of 'rhs' are added, so the literals with a larger
+    // coefficient must be fixed to false.
+    vec<Lit> simp_lits;
+    vec<uint64_t> simp_coeffs;
+    for ( int iVar = 0; iVar < lits.size(); ++iVar ) {
+        if ( coeffs[iVar] == 0 )
+            continue;
+        if ( coeffs[iVar] > rhs )
+            addUnitClause(S, ~lits[iVar]);
+        else {
+            simp_lits.push ( lits[iVar] );
+            simp_coeffs.push ( coeffs[iVar] );
+            }
+        }
+
+    if ( simp_lits.size() == 0 )
+        return;
 
     uint64_t nb = ld64(rhs); // number of bits
     Lit u = lit_Undef;
@@ -272,9 +292,9 @@ void Adder::encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rh
     for ( uint64_t iBit = 0; iBit < nb; ++iBit ) {
         _buckets.push_back ( std::queue<Lit>() );
         _output.push ( u );
-        for ( int iVar = 0; iVar < lits.size(); ++iVar ) {
-            if ( ( ( ((int64_t)1) << iBit ) & coeffs[iVar] ) != 0 )
-                _buckets.back().push ( lits[iVar] );
+        for ( int iVar = 0; iVar < simp_lits.size(); ++iVar ) {
+            if ( ( ( ((int64_t)1) << iBit ) & simp_coeffs[iVar] ) != 0 )
+                _buckets.back().push ( simp_lits[iVar] );
             }
         }
 
@@ -290,6 +310,7 @@ void Adder::encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rh
 
 void Adder::encodeInc(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs, vec<Lit> &assumptions){
     _output.clear();
+    _buckets.clear();
 
     uint64_t nb = ld64(rhs); // number of bits
     Lit u = lit_Undef;
@@ -328,6 +349,78 @@ void Adder::update(Solver *S, uint64_t rhs){
 }
 
 
+/*_________________________________________________________________________________________________
+  |
+  |  predict : (coeffs : vec<uint64_t>&) (rhs : uint64_t) (vars : uint64_t&)
+  |            ->  [uint64_t]
+  |
+  |  Description:
+  |
+  |     Predicts the size of the encoding built by 'encode' for a
+  |     pseudo-Boolean constraint with coefficients 'coeffs' without creating
+  |     it. 'adderTree' is simulated on the number of literals of each bucket:
+  |     a full adder has 2 variables and 20 clauses, a half adder has 2
+  |     variables and 7 clauses. At most one clause per output bit is added
+  |     by 'lessThanOrEqual'.
+  |
+  |  Post-conditions:
+  |    * 'vars' is the number of variables of the encoding.
+  |    * Returns the number of clauses of the encoding.
+  |
+  |________________________________________________________________________________________________@*/
+uint64_t Adder::predict(vec<uint64_t> &coeffs, uint64_t rhs, uint64_t &vars) {
+  vars = 0;
+  uint64_t clauses = 0;
+
+  std::vector<uint64_t> buckets;
+  if (rhs > 0)
+    buckets.resize(ld64(rhs), 0);
+
+  bool empty = true;
+  for (int i = 0; i < coeffs.size(); i++) {
+    if (coeffs[i] == 0)
+      continue;
+
+    if (coeffs[i] > rhs) {
+      clauses++;
+      continue;
+    }
+
+    empty = false;
+    for (size_t iBit = 0; iBit < buckets.size(); iBit++)
+      if (((((uint64_t)1) << iBit) & coeffs[i]) != 0)
+        buckets[iBit]++;
+  }
+
+  if (empty)
+    return clauses;
+
+  for (size_t i = 0; i < buckets.size(); i++) {
+    if (buckets[i] == 0)
+      continue;
+
+    if (i == buckets.size() - 1 && buckets[i] >= 2)
+      buckets.push_back(0);
+
+    if (buckets[i] >= 3) {
+      // Each full adder replaces 3 literals by a sum and a carry.
+      uint64_t full = (buckets[i] - 1) / 2;
+      buckets[i] -= 2 * full;
+      buckets[i + 1] += full;
+      vars += 2 * full;
+      clauses += 20 * full;
+    }
+
+    if (buckets[i] == 2) {
+      buckets[i + 1]++;
+      vars += 2;
+      clauses += 7;
+    }
+  }
+
+  return clauses + buckets.size();
+}
+
 uint64_t Adder::ld64(const uint64_t x)
 {
   return (sizeof(uint64_t) << 3) - __builtin_clzll (x);
@@ -60,6 +60,10 @@ public:
   // Returns true if the encoding was built, otherwise returns false;
   bool hasCreatedEncoding() { return hasEncoding; }
 
+  // Predicts the number of clauses (returned) and variables ('vars') of the
+  // encoding.
+  uint64_t predict(vec<uint64_t> &coeffs, uint64_t rhs, uint64_t &vars);
+
   void encodeInc(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs, vec<Lit> &assumptions);
   void updateInc(Solver *S, uint64_t rhs, vec<Lit>& assumptions);
 
@@ -140,7 +144,7 @@ void wbFilter(uint64_t UB, Solver* S,vec<Lit>& lits,
     } else {
       lits.clear();
       lits.push(~blockings[i]);
-      S->addClause(lits);
+      addClause(S, lits);
     }
   }
 }
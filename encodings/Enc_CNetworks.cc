@@ -344,3 +344,73 @@ void CNetworks::CN_encode(Solver *S, vec<Lit> &a_s, vec<Lit> &c_s,
     CN_smerge(S, lower_d_s, upper_d_s, next_c_s);
   }
 }
+
+/*_________________________________________________________________________________________________
+  |
+  |  predict : (nb_lits : int) (rhs : int64_t) (vars : uint64_t&) ->
+  |            [uint64_t]
+  |
+  |  Description:
+  |
+  |     Predicts the size of the encoding built by 'encode' for a cardinality
+  |     constraint over 'nb_lits' literals without creating it. 'CN_encode'
+  |     sorts the inputs in blocks of 'new_k' literals and merges the blocks
+  |     one by one, which gives the size below.
+  |
+  |  Post-conditions:
+  |    * 'vars' is the number of variables of the encoding.
+  |    * Returns the number of clauses of the encoding.
+  |
+  |________________________________________________________________________________________________@*/
+uint64_t CNetworks::predict(int nb_lits, int64_t rhs, uint64_t &vars) {
+  vars = 0;
+  if (rhs == 0)
+    return nb_lits;
+
+  int64_t new_k = pow(2, floor(log2(rhs)) + 1);
+  int64_t m = ceil((double)nb_lits / new_k) * new_k - nb_lits;
+  uint64_t blocks = (nb_lits + m) / new_k;
+
+  // Padding literals and outputs, and their unit clauses.
+  vars = m + new_k;
+  uint64_t clauses = m + new_k - rhs;
+
+  uint64_t sort_vars = 0;
+  uint64_t sort_clauses = predict_hsort(new_k, sort_vars);
+  uint64_t merge_vars = 0;
+  uint64_t merge_clauses = predict_smerge(new_k, merge_vars);
+
+  vars += blocks * sort_vars + (blocks - 1) * (merge_vars + 2 * new_k + 1);
+  clauses += blocks * sort_clauses + (blocks - 1) * merge_clauses;
+  return clauses;
+}
+
+uint64_t CNetworks::predict_hmerge(uint64_t s, uint64_t &vars) {
+  if (s == 1)
+    return 3;
+
+  uint64_t merge_vars = 0;
+  uint64_t merge_clauses = predict_hmerge(s / 2, merge_vars);
+  vars += 2 * (s - 1) + 2 * merge_vars;
+  return 3 * (s - 1) + 2 * merge_clauses;
+}
+
+uint64_t CNetworks::predict_hsort(uint64_t s, uint64_t &vars) {
+  if (s == 2)
+    return predict_hmerge(1, vars);
+
+  uint64_t sort_vars = 0;
+  uint64_t sort_clauses = predict_hsort(s / 2, sort_vars);
+  vars += s + 2 * sort_vars;
+  return 2 * sort_clauses + predict_hmerge(s / 2, vars);
+}
+
+uint64_t CNetworks::predict_smerge(uint64_t s, uint64_t &vars) {
+  if (s == 1)
+    return 3;
+
+  uint64_t merge_vars = 0;
+  uint64_t merge_clauses = predict_smerge(s / 2, merge_vars);
+  vars += 2 * (s / 2) + 1 + 2 * merge_vars;
+  return 3 * (s / 2) + 2 * merge_clauses;
+}
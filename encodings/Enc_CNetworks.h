@@ -44,6 +44,10 @@ public:
   void encode(Solver *S, vec<Lit> &lits, int64_t rhs);
   void update(Solver *S, int64_t rhs);
 
+  // Predicts the number of clauses (returned) and variables ('vars') of the
+  // encoding of a constraint over 'nb_lits' literals.
+  uint64_t predict(int nb_lits, int64_t rhs, uint64_t &vars);
+
   bool hasCreatedEncoding() { return hasEncoding; }
 
 protected:
@@ -54,6 +58,12 @@ protected:
   void CN_smerge(Solver *S, vec<Lit> &a_s, vec<Lit> &b_s, vec<Lit> &c_s);
   void CN_encode(Solver *S, vec<Lit> &a_s, vec<Lit> &c_s, int64_t rhs);
 
+  // Size of the networks above for inputs of size 's'. Return the number of
+  // clauses and add the number of variables to 'vars'.
+  uint64_t predict_hmerge(uint64_t s, uint64_t &vars);
+  uint64_t predict_hsort(uint64_t s, uint64_t &vars);
+  uint64_t predict_smerge(uint64_t s, uint64_t &vars);
+
   // Stores the current value of the rhs of the cardinality constraint.
   int64_t current_cardinality_rhs;
 
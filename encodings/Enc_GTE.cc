@@ -273,6 +273,277 @@ void GTE::update(Solver *S, uint64_t rhs) {
   current_pb_rhs = rhs;
 }
 
+/*_________________________________________________________________________________________________
+  |
+  |  encode : (S : Solver *) (lits : vec<Lit>&) (coeffs : vec<uint64_t>&)
+  |           (rhs : uint64_t) (assumptions : vec<Lit>&)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Incremental version of the GTE encoding of c_1 x_1 + ... c_n x_n <= rhs.
+  |    The tree of the encoding is kept with flat vectors of outputs sorted by
+  |    weight, so that 'update' can increase the rhs by only creating the new
+  |    outputs of each node, and 'join' can add new literals by building a
+  |    tree for them below a new root. No unit clauses are added: the bound
+  |    is enforced by assuming the negation of the literals in 'assumptions'.
+  |
+  |  Post-conditions:
+  |    * 'assumptions' contains the literals to be assumed for the bound 'rhs'.
+  |    * hasEncoding is set to 'true'.
+  |
+  |________________________________________________________________________________________________@*/
+void GTE::encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
+                 uint64_t rhs, vec<Lit> &assumptions) {
+  if (rhs >= UINT64_MAX - 1) {
+    printf("c Overflow in the Encoding\n");
+    printf("s UNKNOWN\n");
+    exit(_ERROR_);
+  }
+
+  nb_variables = 0;
+  nb_clauses = 0;
+  current_pb_rhs = rhs;
+  current_pb_k = rhs + 1;
+  hasEncoding = true;
+
+  join(S, lits, coeffs, assumptions);
+}
+
+// Increases the largest output weight if needed and updates the assumptions
+// to the bound 'rhs'.
+void GTE::update(Solver *S, uint64_t rhs, vec<Lit> &assumptions) {
+  assert(hasEncoding);
+
+  if (rhs >= UINT64_MAX - 1) {
+    printf("c Overflow in the Encoding\n");
+    printf("s UNKNOWN\n");
+    exit(_ERROR_);
+  }
+
+  if (rhs + 1 > current_pb_k) {
+    current_pb_k = rhs + 1;
+    for (int z = 0; z < inc_left.size(); z++)
+      extend(S, z, current_pb_k);
+    if (inc_wasted > inc_outputs.size() / 2)
+      compact();
+  }
+
+  current_pb_rhs = rhs;
+  updateAssumptions(assumptions);
+}
+
+// Adds the literals 'lits' with coefficients 'coeffs' to the constraint.
+void GTE::join(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
+               vec<Lit> &assumptions) {
+  assert(hasEncoding);
+
+  weightedlitst iliterals;
+  for (int i = 0; i < lits.size(); i++) {
+    if (coeffs[i] == 0)
+      continue;
+
+    if (coeffs[i] >= UINT64_MAX) {
+      printf("c Overflow in the Encoding\n");
+      printf("s UNKNOWN\n");
+      exit(_ERROR_);
+    }
+
+    wlitt wl;
+    wl.lit = lits[i];
+    wl.weight = coeffs[i];
+    iliterals.push_back(wl);
+  }
+
+  if (!iliterals.empty()) {
+    less_than_wlitt lt_wlit;
+    std::sort(iliterals.begin(), iliterals.end(), lt_wlit);
+
+    int root = inc_left.size() - 1;
+    int tree = buildTree(S, iliterals, 0, iliterals.size());
+
+    if (root != -1) {
+      inc_start.push(inc_outputs.size());
+      inc_size.push(0);
+      inc_left.push(root);
+      inc_right.push(tree);
+      inc_sum.push(inc_sum[root] + inc_sum[tree]);
+      inc_k.push(0);
+      extend(S, inc_left.size() - 1, current_pb_k);
+    }
+  }
+
+  updateAssumptions(assumptions);
+}
+
+// The outputs of the root whose weight is larger than the rhs must be false.
+void GTE::updateAssumptions(vec<Lit> &assumptions) {
+  assumptions.clear();
+  if (inc_left.size() == 0)
+    return;
+
+  int root = inc_left.size() - 1;
+  for (int i = firstAbove(root, current_pb_rhs); i < inc_size[root]; i++)
+    assumptions.push(~inc_outputs[inc_start[root] + i].lit);
+}
+
+// Builds the nodes of the literals from 'from' to 'to' (excluded) of
+// 'iliterals' and returns the index of their root.
+int GTE::buildTree(Solver *S, weightedlitst &iliterals, int from, int to) {
+  assert(to > from);
+
+  if (to - from == 1) {
+    inc_start.push(inc_outputs.size());
+    inc_size.push(1);
+    inc_outputs.push(iliterals[from]);
+    inc_left.push(-1);
+    inc_right.push(-1);
+    inc_sum.push(iliterals[from].weight);
+    inc_k.push(iliterals[from].weight);
+    return inc_left.size() - 1;
+  }
+
+  int middle = from + ((to - from) >> 1);
+  int left = buildTree(S, iliterals, from, middle);
+  int right = buildTree(S, iliterals, middle, to);
+
+  inc_start.push(inc_outputs.size());
+  inc_size.push(0);
+  inc_left.push(left);
+  inc_right.push(right);
+  inc_sum.push(inc_sum[left] + inc_sum[right]);
+  inc_k.push(0);
+  extend(S, inc_left.size() - 1, current_pb_k);
+  return inc_left.size() - 1;
+}
+
+// Index of the first output of node 'z' whose weight is larger than 'weight'.
+int GTE::firstAbove(int z, uint64_t weight) {
+  int lo = 0;
+  int hi = inc_size[z];
+  while (lo < hi) {
+    int mid = (lo + hi) >> 1;
+    if (inc_outputs[inc_start[z] + mid].weight > weight)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+// Moves the outputs of node 'z' to the end of 'inc_outputs', so that new
+// outputs can be appended to them.
+void GTE::moveToEnd(int z) {
+  if (inc_start[z] + inc_size[z] == inc_outputs.size())
+    return;
+
+  int start = inc_outputs.size();
+  for (int i = 0; i < inc_size[z]; i++) {
+    // 'push' may reallocate 'inc_outputs', so the output is copied first.
+    wlitt wl = inc_outputs[inc_start[z] + i];
+    inc_outputs.push(wl);
+  }
+  inc_wasted += inc_size[z];
+  inc_start[z] = start;
+}
+
+// Removes the outputs that were left behind by 'moveToEnd'.
+void GTE::compact() {
+  vec<wlitt> outputs;
+  outputs.capacity(inc_outputs.size() - inc_wasted);
+  for (int z = 0; z < inc_left.size(); z++) {
+    int start = outputs.size();
+    for (int i = 0; i < inc_size[z]; i++)
+      outputs.push(inc_outputs[inc_start[z] + i]);
+    inc_start[z] = start;
+  }
+  outputs.moveTo(inc_outputs);
+  inc_wasted = 0;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  extend : (S : Solver *) (z : int) (k : uint64_t)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Creates the outputs of node 'z' up to weight 'k'. The sums of the
+  |    outputs of its children that are larger than the previous largest
+  |    output weight 'c' were mapped to the output 'c'; they are now mapped
+  |    to the output of their sum (or 'k' if the sum is larger than 'k'). All
+  |    these outputs are new and larger than 'c', so they are appended to the
+  |    sorted outputs of the node.
+  |
+  |  Pre-conditions:
+  |    * The children of 'z' have already been extended to 'k'.
+  |
+  |________________________________________________________________________________________________@*/
+void GTE::extend(Solver *S, int z, uint64_t k) {
+  if (inc_left[z] == -1)
+    return;
+
+  uint64_t c = inc_k[z];
+  if (k > inc_sum[z])
+    k = inc_sum[z];
+  if (k <= c)
+    return;
+
+  // Outputs are accessed by index since new outputs may reallocate
+  // 'inc_outputs'.
+  int left = inc_left[z];
+  int right = inc_right[z];
+
+  // Combinations of outputs of the children (-1 stands for no output).
+  vec<int> lindex;
+  vec<int> rindex;
+  vec<uint64_t> weights;
+  for (int i = -1; i < inc_size[left]; i++) {
+    uint64_t lw = i == -1 ? 0 : inc_outputs[inc_start[left] + i].weight;
+    int j = lw > c ? -1 : firstAbove(right, c - lw);
+    for (; j < inc_size[right]; j++) {
+      if (i == -1 && j == -1)
+        continue;
+      uint64_t w =
+          lw + (j == -1 ? 0 : inc_outputs[inc_start[right] + j].weight);
+      lindex.push(i);
+      rindex.push(j);
+      weights.push(w > k ? k : w);
+    }
+  }
+
+  vec<uint64_t> sorted;
+  weights.copyTo(sorted);
+  std::sort((uint64_t *)sorted, (uint64_t *)sorted + sorted.size());
+
+  if (sorted.size() > 0)
+    moveToEnd(z);
+  for (int i = 0; i < sorted.size(); i++) {
+    if (i > 0 && sorted[i] == sorted[i - 1])
+      continue;
+    wlitt wl;
+    wl.lit = getNewLit(S);
+    wl.weight = sorted[i];
+    inc_outputs.push(wl);
+    inc_size[z]++;
+  }
+
+  for (int i = 0; i < weights.size(); i++) {
+    int o = firstAbove(z, weights[i]) - 1;
+    assert(o >= 0 && inc_outputs[inc_start[z] + o].weight == weights[i]);
+    Lit out = inc_outputs[inc_start[z] + o].lit;
+    if (lindex[i] == -1) {
+      addBinaryClause(S, ~inc_outputs[inc_start[right] + rindex[i]].lit, out);
+    } else if (rindex[i] == -1) {
+      addBinaryClause(S, ~inc_outputs[inc_start[left] + lindex[i]].lit, out);
+    } else {
+      addTernaryClause(S, ~inc_outputs[inc_start[left] + lindex[i]].lit,
+                       ~inc_outputs[inc_start[right] + rindex[i]].lit, out);
+    }
+    nb_clauses++;
+  }
+
+  inc_k[z] = k;
+}
+
 // TODO: refactor the code to reduce duplication for the predict methods
 
 // predict number of variables and clauses that this encode will generate
@@ -394,7 +665,7 @@ bool GTE::predictEncodeLeq(uint64_t k, Solver *S, const weightedlitst &iliterals
 }
 
 int GTE::predict(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
-                 uint64_t rhs) {
+                 uint64_t rhs, uint64_t &vars) {
 
   vec<Lit> simp_lits;
   vec<uint64_t> simp_coeffs;
@@ -404,6 +675,8 @@ int GTE::predict(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
   coeffs.clear();
 
   nb_current_variables = S->nVars();
+  nb_clauses_expected = 0;
+  vars = 0;
 
   for (int i = 0; i < simp_lits.size(); i++) {
     if (simp_coeffs[i] == 0)
@@ -434,6 +707,7 @@ int GTE::predict(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
   std::sort(iliterals.begin(), iliterals.end(), lt_wlit);
   wlit_mapt oliterals;
   predictEncodeLeq(rhs + 1, S, iliterals, oliterals);
+  vars = nb_current_variables - S->nVars();
   return nb_clauses_expected;
 
 }
@@ -69,6 +69,8 @@ public:
 
     nb_clauses_expected = 0;
     nb_current_variables = 0;
+    current_pb_k = 0;
+    inc_wasted = 0;
   }
   ~GTE() {}
 
@@ -78,11 +80,27 @@ public:
   // Update constraint.
   void update(Solver *S, uint64_t rhs);
 
+  // Incremental encoding: the bound is enforced through 'assumptions' so
+  // that the rhs can be increased and new literals can be joined to the
+  // constraint without encoding it again.
+  void encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs,
+              vec<Lit> &assumptions);
+  void update(Solver *S, uint64_t rhs, vec<Lit> &assumptions);
+  void join(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
+            vec<Lit> &assumptions);
+  void updateAssumptions(vec<Lit> &assumptions);
+
   // Returns true if the encoding was built, otherwise returns false;
   bool hasCreatedEncoding() { return hasEncoding; }
 
   // Predicts the number of auxiliary clauses for the GTE encoding
-  int predict(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs);
+  int predict(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs) {
+    uint64_t vars;
+    return predict(S, lits, coeffs, rhs, vars);
+  }
+  // Same as above and also predicts the number of variables ('vars').
+  int predict(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs,
+              uint64_t &vars);
 
 protected:
   void printLit(Lit l) { printf("%s%d\n", sign(l) ? "-" : "", var(l) + 1); }
@@ -95,6 +113,12 @@ protected:
                         wlit_mapt &oliterals);
   Lit get_var_predict(Solver *S, wlit_mapt &oliterals, uint64_t weight);
 
+  int buildTree(Solver *S, weightedlitst &iliterals, int from, int to);
+  void extend(Solver *S, int z, uint64_t k);
+  int firstAbove(int z, uint64_t weight);
+  void moveToEnd(int z);
+  void compact();
+
   vec<Lit> pb_outlits; // Stores the outputs of the pseudo-Boolean constraint
                        // encoding for incremental solving.
   uint64_t current_pb_rhs; // Stores the current value of the rhs of the
@@ -105,6 +129,20 @@ protected:
   vec<Lit> unit_lits;
   vec<uint64_t> unit_coeffs;
 
+  // Nodes of the incremental encoding. The children of a node are stored
+  // before it and the root is the last node. The outputs of node 'z' sorted
+  // by weight are 'inc_outputs[inc_start[z]]' to
+  // 'inc_outputs[inc_start[z] + inc_size[z] - 1]'.
+  vec<wlitt> inc_outputs; // Outputs of all nodes.
+  vec<int> inc_start;     // First output of each node.
+  vec<int> inc_size;      // Number of outputs of each node.
+  int inc_wasted;         // Outputs of 'inc_outputs' that no node uses.
+  vec<int> inc_left;      // Children of each node (-1 for the leaves,
+  vec<int> inc_right;     // whose only output is their literal).
+  vec<uint64_t> inc_sum;  // Sum of the weights below each node.
+  vec<uint64_t> inc_k;    // Largest output weight of each node.
+  uint64_t current_pb_k;  // Outputs are created up to this weight.
+
   // Number of variables and clauses for statistics.
   int nb_variables;
   int nb_clauses;
@@ -26,6 +26,7 @@
  */
 
 #include "Enc_MTotalizer.h"
+#include <algorithm>
 
 using namespace openwbo;
 
@@ -352,7 +353,7 @@ void MTotalizer::adder(Solver *S, int mod, vec<Lit> &upper, vec<Lit> &lower,
 
           clause.push(c);
           if (clause.size() > 1) {
-            S->addClause(clause);
+            addClause(S, clause);
           }
         }
 
@@ -366,9 +367,114 @@ void MTotalizer::adder(Solver *S, int mod, vec<Lit> &upper, vec<Lit> &lower,
           clause.push(d);
 
         if (clause.size() > 1) {
-          S->addClause(clause);
+          addClause(S, clause);
         }
       }
     }
   }
 }
+
+/*_________________________________________________________________________________________________
+  |
+  |  predict : (nb_lits : int) (rhs : int64_t) (vars : uint64_t&) ->
+  |            [uint64_t]
+  |
+  |  Description:
+  |
+  |     Predicts the size of the encoding built by 'encode' for a cardinality
+  |     constraint over 'nb_lits' literals without creating it. The tree of
+  |     'toCNF' is followed and the clauses of each node are counted as in
+  |     'adder'.
+  |
+  |  Post-conditions:
+  |    * 'vars' is the number of variables of the encoding.
+  |    * Returns the number of clauses of the encoding.
+  |
+  |________________________________________________________________________________________________@*/
+uint64_t MTotalizer::predict(int nb_lits, int64_t rhs, uint64_t &vars) {
+  vars = 0;
+  if (rhs == 0)
+    return nb_lits;
+
+  if (rhs >= nb_lits)
+    return 0;
+
+  int mod = (modulo == -1) ? ceil(sqrt(rhs + 1)) : modulo;
+  int upper = floor(nb_lits / mod);
+  int lower = mod - 1;
+  vars = upper + lower;
+
+  uint64_t clauses = predictNode(mod, rhs + 1, upper, nb_lits, vars);
+
+  // Clauses of 'encode_output'.
+  int ulimit = floor((rhs + 1) / mod);
+  int llimit = (rhs + 1) - ulimit * mod;
+  clauses += upper - ulimit;
+  clauses += (llimit != 0) ? lower - llimit + 1 : 1;
+
+  return clauses;
+}
+
+// Number of upper and lower outputs that 'toCNF' creates for a node with
+// 'size' literals below it (an upper size of 0 stands for 'h0').
+void MTotalizer::predictOutputs(int mod, int size, int &upper, int &lower,
+                                uint64_t &vars) {
+  if (size == 1) {
+    upper = 0;
+    lower = 1;
+    return;
+  }
+
+  upper = floor(size / mod);
+  lower = mod - 1;
+  if (upper % mod == 0 && size < mod - 1)
+    lower = size;
+  vars += upper + lower;
+}
+
+uint64_t MTotalizer::predictNode(int mod, int64_t rhs, int upper, int size,
+                                 uint64_t &vars) {
+  int split = floor(size / 2);
+  int lupper, llower, rupper, rlower;
+  predictOutputs(mod, split, lupper, llower, vars);
+  predictOutputs(mod, size - split, rupper, rlower, vars);
+
+  uint64_t clauses = 0;
+
+  // Sums of the lower outputs.
+  for (int i = 0; i <= llower; i++) {
+    int limit = rlower;
+    if (rhs + 1 < mod)
+      limit = std::min((int64_t)rlower, rhs + 1 - i);
+    if (limit >= 0)
+      clauses += limit + 1;
+  }
+  clauses--;
+
+  // Carry and sums of the upper outputs.
+  if (upper != 0) {
+    vars++;
+
+    int close_mod = floor(rhs / mod);
+    if (rhs % mod != 0)
+      close_mod++;
+
+    for (int i = 0; i <= std::max(lupper, 1) && i <= close_mod; i++) {
+      for (int j = 0; j <= std::max(rupper, 1) && i + j <= close_mod; j++) {
+        bool a = i != 0 && lupper != 0;
+        bool b = j != 0 && rupper != 0;
+        if ((a || b) && i + j != 0 && i + j - 1 < upper)
+          clauses++;
+        if (a || b || i + j < upper)
+          clauses++;
+      }
+    }
+  }
+
+  if (split > 1)
+    clauses += predictNode(mod, rhs, lupper, split, vars);
+  if (size - split > 1)
+    clauses += predictNode(mod, rhs, rupper, size - split, vars);
+
+  return clauses;
+}
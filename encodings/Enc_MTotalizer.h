@@ -53,6 +53,10 @@ public:
   void update(Solver *S, int64_t rhs);
   void setModulo(int m) { modulo = m; }
 
+  // Predicts the number of clauses (returned) and variables ('vars') of the
+  // encoding of a constraint over 'nb_lits' literals.
+  uint64_t predict(int nb_lits, int64_t rhs, uint64_t &vars);
+
   int getModulo() { return modulo; }
   bool hasCreatedEncoding() { return hasEncoding; }
 
@@ -65,6 +69,10 @@ protected:
              vec<Lit> &lupper, vec<Lit> &llower, vec<Lit> &rupper,
              vec<Lit> &rlower);
   void encode_output(Solver *S, int64_t rhs);
+  uint64_t predictNode(int mod, int64_t rhs, int upper, int size,
+                       uint64_t &vars);
+  void predictOutputs(int mod, int size, int &upper, int &lower,
+                      uint64_t &vars);
 
   Lit h0;     // Temporary literal for the construction of the encoding.
   int modulo; // Stores the modulo value for the encoding.
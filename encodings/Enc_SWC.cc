@@ -155,6 +155,55 @@ void SWC::encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs,
   hasEncoding = true;
 }
 
+/*_________________________________________________________________________________________________
+  |
+  |  predict : (coeffs : vec<uint64_t>&) (rhs : uint64_t) (vars : uint64_t&)
+  |            ->  [uint64_t]
+  |
+  |  Description:
+  |
+  |     Predicts the size of the encoding built by 'encode' for a
+  |     pseudo-Boolean constraint with coefficients 'coeffs' without creating
+  |     it. The clauses are counted as in 'encode'.
+  |
+  |  Post-conditions:
+  |    * 'vars' is the number of variables of the encoding.
+  |    * Returns the number of clauses of the encoding, or UINT64_MAX if the
+  |      coefficients or 'rhs' are too large to be encoded.
+  |
+  |________________________________________________________________________________________________@*/
+uint64_t SWC::predict(vec<uint64_t> &coeffs, uint64_t rhs, uint64_t &vars) {
+  vars = 0;
+  if (rhs >= INT32_MAX)
+    return UINT64_MAX;
+
+  uint64_t units = 0;
+  uint64_t n = 0;
+  uint64_t first = 0;
+  for (int i = 0; i < coeffs.size(); i++) {
+    if (coeffs[i] == 0)
+      continue;
+
+    if (coeffs[i] >= INT32_MAX)
+      return UINT64_MAX;
+
+    if (coeffs[i] <= rhs) {
+      if (n == 0)
+        first = coeffs[i];
+      n++;
+    } else
+      units++;
+  }
+
+  if (n <= 1)
+    return units;
+
+  // The first literal only sets its first 'coeff' counters, the others have
+  // 2 * rhs clauses to update the counters and one clause for the rhs.
+  vars = n * rhs;
+  return units + first + (n - 1) * (2 * rhs + 1);
+}
+
 /*_________________________________________________________________________________________________
   |
   |  encode : (S : Solver *) (lits : vec<Lit>&) (rhs : int64_t)
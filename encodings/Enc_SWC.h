@@ -74,6 +74,10 @@ public:
   // Returns true if the encoding was built, otherwise returns false;
   bool hasCreatedEncoding() { return hasEncoding; }
 
+  // Predicts the number of clauses (returned) and variables ('vars') of the
+  // encoding. Returns UINT64_MAX if the constraint cannot be encoded.
+  uint64_t predict(vec<uint64_t> &coeffs, uint64_t rhs, uint64_t &vars);
+
 protected:
   vec<Lit> pb_outlits;    // Stores the outputs of the pseudo-Boolean constraint
                           // encoding for incremental solving.
@@ -26,6 +26,7 @@
  */
 
 #include "Enc_Totalizer.h"
+#include <algorithm>
 
 using namespace openwbo;
 
@@ -33,6 +34,11 @@ void Totalizer::incremental(Solver *S, int64_t rhs) {
 
   for (int z = 0; z < totalizerIterative_rhs.size(); z++) {
 
+    // Nodes are stored after their children, which are therefore extended
+    // first.
+    if (lazy)
+      extend(S, z, rhs);
+
     // We only need to count the sums up to k.
     for (int i = 0; i <= totalizerIterative_left[z].size(); i++) {
       for (int j = 0; j <= totalizerIterative_right[z].size(); j++) {
@@ -63,11 +69,43 @@ void Totalizer::incremental(Solver *S, int64_t rhs) {
     }
     totalizerIterative_rhs[z] = rhs;
   }
+
+  if (lazy && totalizerIterative_output.size() > 0)
+    totalizerIterative_output.last().copyTo(cardinality_outlits);
+}
+
+// Creates the outputs of node 'z' up to 'rhs' + 1 and adds the new outputs of
+// its children to its inputs.
+void Totalizer::extend(Solver *S, int z, int64_t rhs) {
+  int left_node = totalizerIterative_leftNode[z];
+  int right_node = totalizerIterative_rightNode[z];
+
+  if (left_node != -1) {
+    for (int i = totalizerIterative_left[z].size();
+         i < totalizerIterative_output[left_node].size(); i++)
+      totalizerIterative_left[z].push(totalizerIterative_output[left_node][i]);
+  }
+
+  if (right_node != -1) {
+    for (int i = totalizerIterative_right[z].size();
+         i < totalizerIterative_output[right_node].size(); i++)
+      totalizerIterative_right[z].push(
+          totalizerIterative_output[right_node][i]);
+  }
+
+  while (totalizerIterative_output[z].size() < totalizerIterative_size[z] &&
+         totalizerIterative_output[z].size() <= rhs) {
+    Lit p = mkLit(S->nVars(), false);
+    newSATVariable(S);
+    n_variables++;
+    totalizerIterative_output[z].push(p);
+  }
 }
 
 void Totalizer::join(Solver *S, vec<Lit> &lits, int64_t rhs) {
 
   assert(incremental_strategy == _INCREMENTAL_ITERATIVE_);
+  assert(!lazy);
 
   vec<Lit> left_cardinality_outlits;
   cardinality_outlits.copyTo(left_cardinality_outlits);
@@ -105,8 +143,8 @@ void Totalizer::join(Solver *S, vec<Lit> &lits, int64_t rhs) {
 }
 
 void Totalizer::adder(Solver *S, vec<Lit> &left, vec<Lit> &right,
-                      vec<Lit> &output) {
-  assert(output.size() == left.size() + right.size());
+                      vec<Lit> &output, int left_node, int right_node) {
+  assert(lazy || output.size() == left.size() + right.size());
   if (incremental_strategy == _INCREMENTAL_ITERATIVE_) {
     totalizerIterative_left.push();
     new (&totalizerIterative_left[totalizerIterative_left.size() - 1])
@@ -121,6 +159,11 @@ void Totalizer::adder(Solver *S, vec<Lit> &left, vec<Lit> &right,
         vec<Lit>();
     output.copyTo(totalizerIterative_output.last());
     totalizerIterative_rhs.push(current_cardinality_rhs);
+    totalizerIterative_leftNode.push(left_node);
+    totalizerIterative_rightNode.push(right_node);
+    totalizerIterative_size.push(
+        (left_node == -1 ? left.size() : totalizerIterative_size[left_node]) +
+        (right_node == -1 ? right.size() : totalizerIterative_size[right_node]));
   }
 
   // We only need to count the sums up to k.
@@ -147,15 +190,15 @@ void Totalizer::adder(Solver *S, vec<Lit> &left, vec<Lit> &right,
   }
 }
 
-void Totalizer::toCNF(Solver *S, vec<Lit> &lits) {
+void Totalizer::toCNF(Solver *S, vec<Lit> &lits, int size) {
 
   vec<Lit> left;
   vec<Lit> right;
 
-  assert(lits.size() > 1);
-  int split = floor(lits.size() / 2);
+  assert(size > 1);
+  int split = floor(size / 2);
 
-  for (int i = 0; i < lits.size(); i++) {
+  for (int i = 0; i < size; i++) {
 
     if (i < split) {
       // left branch
@@ -163,7 +206,7 @@ void Totalizer::toCNF(Solver *S, vec<Lit> &lits) {
         assert(cardinality_inlits.size() > 0);
         left.push(cardinality_inlits.last());
         cardinality_inlits.pop();
-      } else {
+      } else if (!lazy || left.size() <= current_cardinality_rhs) {
         Lit p = mkLit(S->nVars(), false);
         newSATVariable(S);
         left.push(p);
@@ -171,11 +214,11 @@ void Totalizer::toCNF(Solver *S, vec<Lit> &lits) {
     } else {
 
       // right branch
-      if (lits.size() - split == 1) {
+      if (size - split == 1) {
         assert(cardinality_inlits.size() > 0);
         right.push(cardinality_inlits.last());
         cardinality_inlits.pop();
-      } else {
+      } else if (!lazy || right.size() <= current_cardinality_rhs) {
         Lit p = mkLit(S->nVars(), false);
         newSATVariable(S);
         right.push(p);
@@ -183,11 +226,17 @@ void Totalizer::toCNF(Solver *S, vec<Lit> &lits) {
     }
   }
 
-  if (left.size() > 1)
-    toCNF(S, left);
-  if (right.size() > 1)
-    toCNF(S, right);
-  adder(S, left, right, lits);
+  int left_node = -1;
+  int right_node = -1;
+  if (split > 1) {
+    toCNF(S, left, split);
+    left_node = totalizerIterative_rhs.size() - 1;
+  }
+  if (size - split > 1) {
+    toCNF(S, right, size - split);
+    right_node = totalizerIterative_rhs.size() - 1;
+  }
+  adder(S, left, right, lits, left_node, right_node);
 }
 
 void Totalizer::update(Solver *S, int64_t rhs, vec<Lit> &lits,
@@ -240,7 +289,9 @@ void Totalizer::update(Solver *S, int64_t rhs, vec<Lit> &lits,
 void Totalizer::add(Solver *S, Totalizer &tot, int64_t rhs) {
   assert(incremental_strategy == _INCREMENTAL_ITERATIVE_ &&
          tot.incremental_strategy == _INCREMENTAL_ITERATIVE_);
+  assert(!lazy && !tot.lazy);
   int left_idx = totalizerIterative_rhs.size() - 1;
+  int offset = totalizerIterative_rhs.size();
   for (int i = 0; i < tot.totalizerIterative_rhs.size(); ++i) {
     totalizerIterative_left.push();
     new (&totalizerIterative_left[totalizerIterative_left.size() - 1])
@@ -255,6 +306,12 @@ void Totalizer::add(Solver *S, Totalizer &tot, int64_t rhs) {
         vec<Lit>();
     tot.totalizerIterative_output[i].copyTo(totalizerIterative_output.last());
     totalizerIterative_rhs.push(tot.totalizerIterative_rhs[i]);
+    int left_node = tot.totalizerIterative_leftNode[i];
+    int right_node = tot.totalizerIterative_rightNode[i];
+    totalizerIterative_leftNode.push(left_node == -1 ? -1 : left_node + offset);
+    totalizerIterative_rightNode.push(right_node == -1 ? -1
+                                                       : right_node + offset);
+    totalizerIterative_size.push(tot.totalizerIterative_size[i]);
   }
   int right_idx = totalizerIterative_rhs.size() - 1;
 
@@ -268,7 +325,7 @@ void Totalizer::add(Solver *S, Totalizer &tot, int64_t rhs) {
     cardinality_outlits.push(p);
   }
   current_cardinality_rhs = rhs;
-  adder(S, left, right, cardinality_outlits);
+  adder(S, left, right, cardinality_outlits, left_idx, right_idx);
 }
 
 /*_________________________________________________________________________________________________
@@ -315,7 +372,8 @@ void Totalizer::build(Solver *S, vec<Lit> &lits, int64_t rhs) {
   if (rhs == lits.size() && !joinMode)
     return;
 
-  for (int i = 0; i < lits.size(); i++) {
+  assert(!lazy || incremental_strategy == _INCREMENTAL_ITERATIVE_);
+  for (int i = 0; i < lits.size() && (!lazy || i <= rhs); i++) {
     Lit p = mkLit(S->nVars(), false);
     newSATVariable(S);
     cardinality_outlits.push(p);
@@ -335,7 +393,7 @@ void Totalizer::build(Solver *S, vec<Lit> &lits, int64_t rhs) {
     blocking = p;
   }
 
-  toCNF(S, cardinality_outlits);
+  toCNF(S, cardinality_outlits, lits.size());
   assert(cardinality_inlits.size() == 0);
 
   if (!joinMode)
@@ -344,3 +402,54 @@ void Totalizer::build(Solver *S, vec<Lit> &lits, int64_t rhs) {
 
   lits.copyTo(ilits);
 }
+
+/*_________________________________________________________________________________________________
+  |
+  |  predict : (nb_lits : int) (rhs : int64_t) (vars : uint64_t&) ->
+  |            [uint64_t]
+  |
+  |  Description:
+  |
+  |     Predicts the size of the encoding built by 'build' and 'update' for a
+  |     cardinality constraint over 'nb_lits' literals without creating it.
+  |     The tree of 'toCNF' is followed and the clauses of each node are
+  |     counted as in 'adder'.
+  |
+  |  Post-conditions:
+  |    * 'vars' is the number of variables of the encoding.
+  |    * Returns the number of clauses of the encoding.
+  |
+  |________________________________________________________________________________________________@*/
+uint64_t Totalizer::predict(int nb_lits, int64_t rhs, uint64_t &vars) {
+  vars = 0;
+  if (rhs == 0)
+    return nb_lits;
+
+  if (rhs >= nb_lits)
+    return 0;
+
+  vars = nb_lits;
+  return predictNode(nb_lits, rhs, vars) + (nb_lits - rhs);
+}
+
+uint64_t Totalizer::predictNode(int size, int64_t rhs, uint64_t &vars) {
+  int split = floor(size / 2);
+  int64_t left = split;
+  int64_t right = size - split;
+  uint64_t clauses = 0;
+
+  if (left > 1) {
+    vars += left;
+    clauses += predictNode(left, rhs, vars);
+  }
+  if (right > 1) {
+    vars += right;
+    clauses += predictNode(right, rhs, vars);
+  }
+
+  // Sums i + j of the inputs with 0 < i + j <= rhs + 1.
+  for (int64_t i = 0; i <= left && i <= rhs + 1; i++)
+    clauses += std::min(right, rhs + 1 - i) + 1;
+
+  return clauses - 1;
+}
@@ -46,6 +46,7 @@ public:
     blocking = lit_Undef;
     hasEncoding = false;
     joinMode = false;
+    lazy = false;
     current_cardinality_rhs = -1; // -1 corresponds to an unitialized value
     incremental_strategy = strategy;
 
@@ -64,10 +65,20 @@ public:
   }
   void add(Solver *S, Totalizer &tot, int64_t rhs);
 
+  // Predicts the number of clauses (returned) and variables ('vars') of the
+  // non-incremental encoding of a constraint over 'nb_lits' literals.
+  uint64_t predict(int nb_lits, int64_t rhs, uint64_t &vars);
+
   bool hasCreatedEncoding() { return hasEncoding; }
   void setIncremental(int incremental) { incremental_strategy = incremental; }
   int getIncremental() { return incremental_strategy; }
 
+  // Lazy outputs (iterative strategy only): the output variables of each
+  // node are only created up to the current bound plus one, and are extended
+  // by 'update' when the bound is increased. 'outputs' then only contains the
+  // outputs that have been created so far.
+  void setLazy(bool l) { lazy = l; }
+
   // void enableConstraintBlocker(Solver* S)
   // {
   //   if (incremental_strategy == _INCREMENTAL_BLOCKING_)
@@ -100,14 +111,22 @@ public:
 
 protected:
   void encode(Solver *S, vec<Lit> &lits);
-  void adder(Solver *S, vec<Lit> &left, vec<Lit> &right, vec<Lit> &output);
+  void adder(Solver *S, vec<Lit> &left, vec<Lit> &right, vec<Lit> &output,
+             int left_node = -1, int right_node = -1);
   void incremental(Solver *S, int64_t rhs);
-  void toCNF(Solver *S, vec<Lit> &lits);
+  void extend(Solver *S, int z, int64_t rhs);
+  void toCNF(Solver *S, vec<Lit> &lits, int size);
+  uint64_t predictNode(int size, int64_t rhs, uint64_t &vars);
 
   vec<vec<Lit>> totalizerIterative_left;
   vec<vec<Lit>> totalizerIterative_right;
   vec<vec<Lit>> totalizerIterative_output;
   vec<int64_t> totalizerIterative_rhs;
+  // Node whose outputs are the left/right inputs of each node (-1 if the
+  // inputs are literals of the constraint) and number of literals below it.
+  vec<int> totalizerIterative_leftNode;
+  vec<int> totalizerIterative_rightNode;
+  vec<int> totalizerIterative_size;
 
   Lit blocking; // Controls the blocking literal for the incremental blocking.
   bool hasEncoding;
@@ -126,6 +145,7 @@ protected:
 
   vec<Lit> disable_lits; // Contains a vector with a list of blocking literals.
   bool joinMode;
+  bool lazy;
 
   int n_clauses;
   int n_variables;
@@ -37,8 +37,7 @@ void Encodings::addUnitClause(Solver *S, Lit a, Lit blocking) {
   clause.push(a);
   if (blocking != lit_Undef)
     clause.push(blocking);
-  S->addClause(clause);
-  clause.clear();
+  commitClause(S);
 }
 
 // Creates a binary clause in the SAT solver
@@ -50,8 +49,7 @@ void Encodings::addBinaryClause(Solver *S, Lit a, Lit b, Lit blocking) {
   clause.push(b);
   if (blocking != lit_Undef)
     clause.push(blocking);
-  S->addClause(clause);
-  clause.clear();
+  commitClause(S);
 }
 
 // Creates a ternary clause in the SAT solver
@@ -64,8 +62,7 @@ void Encodings::addTernaryClause(Solver *S, Lit a, Lit b, Lit c, Lit blocking) {
   clause.push(c);
   if (blocking != lit_Undef)
     clause.push(blocking);
-  S->addClause(clause);
-  clause.clear();
+  commitClause(S);
 }
 
 // Creates a quaternary clause in the SAT solver
@@ -81,6 +78,27 @@ void Encodings::addQuaternaryClause(Solver *S, Lit a, Lit b, Lit c, Lit d,
   clause.push(d);
   if (blocking != lit_Undef)
     clause.push(blocking);
+  commitClause(S);
+}
+
+// Creates a clause in the SAT solver
+void Encodings::addClause(Solver *S, vec<Lit> &lits) {
+  assert(clause.size() == 0);
+  for (int i = 0; i < lits.size(); i++) {
+    assert(lits[i] != lit_Undef && var(lits[i]) < S->nVars());
+    clause.push(lits[i]);
+  }
+  commitClause(S);
+}
+
+// Adds the clause in 'clause' to the SAT solver and to the record, if any.
+void Encodings::commitClause(Solver *S) {
+  if (record_lits != NULL) {
+    for (int i = 0; i < clause.size(); i++)
+      record_lits->push(clause[i]);
+    record_sizes->push(clause.size());
+  }
+
   S->addClause(clause);
   clause.clear();
 }
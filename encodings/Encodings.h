@@ -50,7 +50,11 @@ namespace openwbo {
 class Encodings {
 
 public:
-  Encodings() { hasEncoding = false; }
+  Encodings() {
+    hasEncoding = false;
+    record_lits = NULL;
+    record_sizes = NULL;
+  }
   ~Encodings() {}
 
   // Auxiliary methods for creating clauses
@@ -65,6 +69,16 @@ public:
   // Add a quaternary clause to a SAT solver
   void addQuaternaryClause(Solver *S, Lit a, Lit b, Lit c, Lit d,
                            Lit blocking = lit_Undef);
+  // Add a clause of any size to a SAT solver
+  void addClause(Solver *S, vec<Lit> &lits);
+
+  // Appends the clauses given to the SAT solver to 'lits' and 'sizes': the
+  // literals of all clauses and the size of each one (see 'EncodingCache').
+  // NULL stops the recording.
+  void setRecord(vec<Lit> *lits, vec<int> *sizes) {
+    record_lits = lits;
+    record_sizes = sizes;
+  }
 
   // Creates a new variable in the SAT solver
   void newSATVariable(Solver *S) {
@@ -76,8 +90,13 @@ public:
   }
 
 protected:
+  void commitClause(Solver *S);
+
   vec<Lit> clause; // Temporary clause to be used while building the encodings.
   bool hasEncoding;
+
+  vec<Lit> *record_lits;
+  vec<int> *record_sizes;
 };
 } // namespace openwbo
 